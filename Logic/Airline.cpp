@@ -4,7 +4,7 @@
  * @brief Default constructor for the Airline class.
  * @details Time complexity: O(1)
  */
-Airline::Airline() {}
+Airline::Airline() : code(StringPool::airlineCodes().intern("")) {}
 
 /**
  * @brief Parameterized constructor for the Airline class.
@@ -15,14 +15,23 @@ Airline::Airline() {}
  * @details Time complexity: O(1)
  */
 Airline::Airline(const std::string code, const std::string name, const std::string callSign, const std::string country) :
-        code(code), name(name), callSign(callSign), country(country) {}
+        code(StringPool::airlineCodes().intern(code)), name(name), callSign(callSign), country(country) {}
 
 /**
  * @brief Getter function for retrieving the airline code.
  * @return The airline code.
  * @details Time complexity: O(1)
  */
-std::string Airline::getCode() const {
+const std::string& Airline::getCode() const {
+    return StringPool::airlineCodes().get(code);
+}
+
+/**
+ * @brief Getter function for retrieving the interned id of the airline code.
+ * @return The id of the code in StringPool::airlineCodes().
+ * @details Time complexity: O(1)
+ */
+int Airline::getCodeId() const {
     return code;
 }
 
@@ -31,7 +40,7 @@ std::string Airline::getCode() const {
  * @return The name of the airline.
  * @details Time complexity: O(1)
  */
-std::string Airline::getName() const {
+const std::string& Airline::getName() const {
     return name;
 }
 
@@ -40,7 +49,7 @@ std::string Airline::getName() const {
  * @return The call sign of the airline.
  * @details Time complexity: O(1)
  */
-std::string Airline::getCallSign() const {
+const std::string& Airline::getCallSign() const {
     return callSign;
 }
 
@@ -49,7 +58,7 @@ std::string Airline::getCallSign() const {
  * @return The country of the airline.
  * @details Time complexity: O(1)
  */
-std::string Airline::getCountry() const {
+const std::string& Airline::getCountry() const {
     return country;
 }
 
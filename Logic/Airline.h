@@ -2,6 +2,7 @@
 #define PROJETO_2_AIRLINE_H
 
 #include <string>
+#include "StringPool.h"
 
 /**
  * @class Airline
@@ -9,7 +10,7 @@
  */
 class Airline {
 private:
-    std::string code;
+    int code;
     std::string name;
     std::string callSign;
     std::string country;
@@ -36,28 +37,35 @@ public:
      * @return The airline code.
      * @details Time complexity: O(1)
      */
-    std::string getCode() const;
+    const std::string& getCode() const;
+
+    /**
+     * @brief Getter function for retrieving the interned id of the airline code.
+     * @return The id of the code in StringPool::airlineCodes().
+     * @details Time complexity: O(1)
+     */
+    int getCodeId() const;
 
     /**
      * @brief Getter function for retrieving the name of the airline.
      * @return The name of the airline.
      * @details Time complexity: O(1)
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * @brief Getter function for retrieving the call sign of the airline.
      * @return The call sign of the airline.
      * @details Time complexity: O(1)
      */
-    std::string getCallSign() const;
+    const std::string& getCallSign() const;
 
     /**
      * @brief Getter function for retrieving the country to which the airline belongs.
      * @return The country of the airline.
      * @details Time complexity: O(1)
      */
-    std::string getCountry() const;
+    const std::string& getCountry() const;
 
     /**
      * @brief Overloaded equality operator for comparing two airlines.
@@ -81,8 +89,7 @@ struct std::hash<Airline> {
      * @details Time complexity: O(1)
      */
     size_t operator()(const Airline& airline) const {
-        size_t airlineCode = std::hash<std::string>{}(airline.getCode());
-        return airlineCode; // Combine the hashes appropriately
+        return std::hash<int>{}(airline.getCodeId());
     }
 };
 
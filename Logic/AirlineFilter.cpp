@@ -0,0 +1,39 @@
+#include "AirlineFilter.h"
+#include "StringPool.h"
+
+/**
+ * @brief Builds a filter that allows every airline.
+ * @details Time complexity: O(1)
+ */
+AirlineFilter::AirlineFilter() : numIds(0), outside(true), all(true) {}
+
+/**
+ * @brief Compiles an airline filter.
+ * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
+ * @param airlines Set of airline codes to avoid or include based on the choice.
+ * @details Time complexity: O(N + A), where N is the number of interned airline codes and A the number of
+ * airlines given.
+ */
+AirlineFilter::AirlineFilter(int choice, const std::unordered_set<std::string>& airlines) : AirlineFilter() {
+    if (choice != 2 && choice != 3) {
+        return;
+    }
+
+    // Airlines interned after the filter was built were never named in it
+    all = false;
+    outside = choice == 2;
+    numIds = StringPool::airlineCodes().size();
+    bits.assign((numIds + 63) / 64, outside ? ~uint64_t(0) : 0);
+
+    for (const auto& code : airlines) {
+        int id = StringPool::airlineCodes().find(code);
+        if (id == StringPool::NotFound || (size_t) id >= numIds) {
+            continue;
+        }
+        if (choice == 3) {
+            bits[id >> 6] |= uint64_t(1) << (id & 63);
+        } else {
+            bits[id >> 6] &= ~(uint64_t(1) << (id & 63));
+        }
+    }
+}
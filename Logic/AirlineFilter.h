@@ -0,0 +1,58 @@
+#ifndef PROJETO_2_AIRLINEFILTER_H
+#define PROJETO_2_AIRLINEFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class AirlineFilter
+ * @brief An airline filter compiled to a bitset over the interned airline ids.
+ *
+ * Built once per query from the airline codes the user typed, so testing a flight is a single bit probe instead of
+ * hashing its airline code. A default-constructed filter allows every airline and lets traversals skip the test.
+ */
+class AirlineFilter {
+public:
+    /**
+     * @brief Builds a filter that allows every airline.
+     * @details Time complexity: O(1)
+     */
+    AirlineFilter();
+
+    /**
+     * @brief Compiles an airline filter.
+     * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
+     * @param airlines Set of airline codes to avoid or include based on the choice.
+     * @details Time complexity: O(N + A), where N is the number of interned airline codes and A the number of
+     * airlines given.
+     */
+    AirlineFilter(int choice, const std::unordered_set<std::string>& airlines);
+
+    /**
+     * @brief Tells whether the filter lets every airline through.
+     * @details Time complexity: O(1)
+     */
+    bool allowsAll() const { return all; }
+
+    /**
+     * @brief Tells whether flights of an airline may be taken.
+     * @param airlineId The id of the airline code in StringPool::airlineCodes().
+     * @details Time complexity: O(1)
+     */
+    bool allows(int airlineId) const {
+        if ((size_t) airlineId >= numIds) {
+            return outside;
+        }
+        return (bits[airlineId >> 6] >> (airlineId & 63)) & 1;
+    }
+
+private:
+    std::vector<uint64_t> bits;
+    size_t numIds;
+    bool outside;
+    bool all;
+};
+
+#endif //PROJETO_2_AIRLINEFILTER_H
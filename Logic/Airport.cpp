@@ -4,7 +4,9 @@
  * @brief Default constructor for the Airport class.
  * @details Time complexity: O(1)
  */
-Airport::Airport(): code(""), name(" "), city(" "), latitude(0.0), longitude(0.0) {}
+Airport::Airport(): code(StringPool::airportCodes().intern("")), name(StringPool::airportNames().intern(" ")),
+                   city(StringPool::cities().intern(" ")), country(StringPool::countries().intern("")),
+                   longitude(0.0), latitude(0.0) {}
 
 /**
  * @brief Parameterized constructor for the Airport class.
@@ -18,14 +20,19 @@ Airport::Airport(): code(""), name(" "), city(" "), latitude(0.0), longitude(0.0
  */
 Airport::Airport(const std::string &code, const std::string name, const std::string city, const std::string country,
                  double latitude, double longitude)
-        : code(code), name(name), city(city), country(country), latitude(latitude), longitude(longitude) {}
+        : code(StringPool::airportCodes().intern(code)), name(StringPool::airportNames().intern(name)),
+          city(StringPool::cities().intern(city)), country(StringPool::countries().intern(country)),
+          longitude(longitude), latitude(latitude) {}
 
 /**
  * @brief Constructor for the Airport class with only a code parameter.
  * @param code The airport code.
  * @details Time complexity: O(1)
  */
-Airport::Airport(std::string code) : code(std::move(code)), name(" "), city(" "), latitude(0.0), longitude(0.0) {}
+Airport::Airport(std::string code) : code(StringPool::airportCodes().intern(code)),
+                                     name(StringPool::airportNames().intern(" ")),
+                                     city(StringPool::cities().intern(" ")),
+                                     country(StringPool::countries().intern("")), longitude(0.0), latitude(0.0) {}
 
 // Getters
 
@@ -34,8 +41,8 @@ Airport::Airport(std::string code) : code(std::move(code)), name(" "), city(" ")
  * @return The airport code.
  * @details Time complexity: O(1)
  */
-std::string Airport::getCode() const {
-    return code;
+const std::string& Airport::getCode() const {
+    return StringPool::airportCodes().get(code);
 }
 
 /**
@@ -43,8 +50,8 @@ std::string Airport::getCode() const {
  * @return The name of the airport.
  * @details Time complexity: O(1)
  */
-std::string Airport::getName() const {
-    return name;
+const std::string& Airport::getName() const {
+    return StringPool::airportNames().get(name);
 }
 
 /**
@@ -52,8 +59,8 @@ std::string Airport::getName() const {
  * @return The city of the airport.
  * @details Time complexity: O(1)
  */
-std::string Airport::getCity() const {
-    return city;
+const std::string& Airport::getCity() const {
+    return StringPool::cities().get(city);
 }
 
 /**
@@ -61,7 +68,34 @@ std::string Airport::getCity() const {
  * @return The country of the airport.
  * @details Time complexity: O(1)
  */
-std::string Airport::getCountry() const {
+const std::string& Airport::getCountry() const {
+    return StringPool::countries().get(country);
+}
+
+/**
+ * @brief Getter function for retrieving the interned id of the airport code.
+ * @return The id of the code in StringPool::airportCodes().
+ * @details Time complexity: O(1)
+ */
+int Airport::getCodeId() const {
+    return code;
+}
+
+/**
+ * @brief Getter function for retrieving the interned id of the city.
+ * @return The id of the city in StringPool::cities().
+ * @details Time complexity: O(1)
+ */
+int Airport::getCityId() const {
+    return city;
+}
+
+/**
+ * @brief Getter function for retrieving the interned id of the country.
+ * @return The id of the country in StringPool::countries().
+ * @details Time complexity: O(1)
+ */
+int Airport::getCountryId() const {
     return country;
 }
 
@@ -91,7 +125,7 @@ double Airport::getLatitude() const {
  * @details Time complexity: O(1)
  */
 void Airport::setCode(const std::string &newCode) {
-    code = newCode;
+    code = StringPool::airportCodes().intern(newCode);
 }
 
 /**
@@ -100,7 +134,7 @@ void Airport::setCode(const std::string &newCode) {
  * @details Time complexity: O(1)
  */
 void Airport::setName(const std::string &newName) {
-    name = newName;
+    name = StringPool::airportNames().intern(newName);
 }
 
 /**
@@ -109,7 +143,7 @@ void Airport::setName(const std::string &newName) {
  * @details Time complexity: O(1)
  */
 void Airport::setCity(const std::string &newCity) {
-    city = newCity;
+    city = StringPool::cities().intern(newCity);
 }
 
 /**
@@ -118,7 +152,7 @@ void Airport::setCity(const std::string &newCity) {
  * @details Time complexity: O(1)
  */
 void Airport::setCountry(const std::string &newCountry) {
-    country = newCountry;
+    country = StringPool::countries().intern(newCountry);
 }
 
 /**
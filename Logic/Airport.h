@@ -2,10 +2,14 @@
 #define PROJETO_2_AIRPORT_H
 
 #include <string>
+#include "StringPool.h"
 
 /**
  * @class Airport
  * @brief Represents an airport with information such as code, name, city, country, location , etc...
+ *
+ * The code, name, city and country are interned in the StringPool, so an airport only holds their ids and can be
+ * copied, compared and hashed without touching any string.
  */
 class Airport {
 public:
@@ -42,28 +46,49 @@ public:
      * @return The airport code.
      * @details Time complexity: O(1)
      */
-    std::string getCode() const;
+    const std::string& getCode() const;
 
     /**
      * @brief Getter function for retrieving the name of the airport.
      * @return The name of the airport.
      * @details Time complexity: O(1)
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * @brief Getter function for retrieving the city where the airport is located.
      * @return The city of the airport.
      * @details Time complexity: O(1)
      */
-    std::string getCity() const;
+    const std::string& getCity() const;
 
     /**
      * @brief Getter function for retrieving the country to which the airport belongs.
      * @return The country of the airport.
      * @details Time complexity: O(1)
      */
-    std::string getCountry() const;
+    const std::string& getCountry() const;
+
+    /**
+     * @brief Getter function for retrieving the interned id of the airport code.
+     * @return The id of the code in StringPool::airportCodes().
+     * @details Time complexity: O(1)
+     */
+    int getCodeId() const;
+
+    /**
+     * @brief Getter function for retrieving the interned id of the city.
+     * @return The id of the city in StringPool::cities().
+     * @details Time complexity: O(1)
+     */
+    int getCityId() const;
+
+    /**
+     * @brief Getter function for retrieving the interned id of the country.
+     * @return The id of the country in StringPool::countries().
+     * @details Time complexity: O(1)
+     */
+    int getCountryId() const;
 
     /**
      * @brief Getter function for retrieving the longitude of the airport.
@@ -139,10 +164,10 @@ public:
     void operator=(const Airport &other);
 
 private:
-    std::string code;
-    std::string name;
-    std::string city;
-    std::string country;
+    int code;
+    int name;
+    int city;
+    int country;
     double longitude;
     double latitude;
 };
@@ -161,8 +186,7 @@ struct std::hash<Airport> {
      * @details Time complexity: O(1)
      */
     size_t operator()(const Airport &airport) const {
-        size_t airportCode = std::hash<std::string>{}(airport.getCode());
-        return airportCode; // Combine the hashes appropriately
+        return std::hash<int>{}(airport.getCodeId());
     }
 };
 
@@ -0,0 +1,92 @@
+#include "AirportStats.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+// Airports per task of the parallel pass
+static const int BlockSize = 256;
+
+/**
+ * @brief Counts the distinct values of a list.
+ * @param values The values; sorted in place.
+ * @return The number of distinct values.
+ * @details Time complexity: O(n log n)
+ */
+static int countDistinct(std::vector<int>& values) {
+    std::sort(values.begin(), values.end());
+    return (int) (std::unique(values.begin(), values.end()) - values.begin());
+}
+
+/**
+ * @brief Builds an empty table.
+ * @details Time complexity: O(1)
+ */
+AirportStats::AirportStats() = default;
+
+/**
+ * @brief Computes the statistics of every airport of a graph.
+ * @param graph The graph; the table keeps its ids but no reference to it.
+ * @details Time complexity: O(V + F log D), where F is the number of flights and D the greatest number of flights
+ * out of an airport, divided between the threads of the shared pool.
+ */
+AirportStats::AirportStats(const CsrGraph& graph) {
+    int n = graph.getNumVertex();
+    std::vector<int> out(n), airlineCounts(n), destinationCounts(n), cityCounts(n), countryCounts(n), in(n);
+
+    int blocks = (n + BlockSize - 1) / BlockSize;
+    ThreadPool::getShared().parallelFor(blocks, [&](size_t block) {
+        std::vector<int> airlineIds, cityIds, countryIds;
+        int first = (int) block * BlockSize;
+        int last = std::min(n, first + BlockSize);
+        for (int v = first; v < last; v++) {
+            airlineIds.clear();
+            cityIds.clear();
+            countryIds.clear();
+            for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+                for (int i = graph.edgeAirlinesBegin(e); i < graph.edgeAirlinesEnd(e); i++) {
+                    airlineIds.push_back(graph.flightAirline(i));
+                }
+                const Airport& dest = graph.getAirport(graph.edgeDest(e));
+                cityIds.push_back(dest.getCityId());
+                countryIds.push_back(dest.getCountryId());
+            }
+            out[v] = graph.flightsOut(v);
+            airlineCounts[v] = countDistinct(airlineIds);
+            destinationCounts[v] = graph.edgesEnd(v) - graph.edgesBegin(v);
+            cityCounts[v] = countDistinct(cityIds);
+            countryCounts[v] = countDistinct(countryIds);
+
+            int flights = 0;
+            for (int e = graph.inEdgesBegin(v); e < graph.inEdgesEnd(v); e++) {
+                int route = graph.inEdgeRoute(e);
+                flights += graph.edgeAirlinesEnd(route) - graph.edgeAirlinesBegin(route);
+            }
+            in[v] = flights;
+        }
+    });
+
+    flightsOut = Column<int>(std::move(out));
+    airlines = Column<int>(std::move(airlineCounts));
+    destinations = Column<int>(std::move(destinationCounts));
+    cities = Column<int>(std::move(cityCounts));
+    countries = Column<int>(std::move(countryCounts));
+    flightsIn = Column<int>(std::move(in));
+}
+
+/**
+ * @brief Restores a table computed earlier, e.g. by a snapshot.
+ * @param columns The columns, all with one entry per airport.
+ * @details Time complexity: O(1)
+ */
+AirportStats::AirportStats(Columns columns)
+        : flightsOut(std::move(columns.flightsOut)), airlines(std::move(columns.airlines)),
+          destinations(std::move(columns.destinations)), cities(std::move(columns.cities)),
+          countries(std::move(columns.countries)), flightsIn(std::move(columns.flightsIn)) {}
+
+/**
+ * @brief Gets the columns of the table, sharing their storage.
+ * @return The columns.
+ * @details Time complexity: O(1)
+ */
+AirportStats::Columns AirportStats::getColumns() const {
+    return {flightsOut, airlines, destinations, cities, countries, flightsIn};
+}
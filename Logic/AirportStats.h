@@ -0,0 +1,110 @@
+#ifndef PROJETO_2_AIRPORTSTATS_H
+#define PROJETO_2_AIRPORTSTATS_H
+
+#include <vector>
+#include "Column.h"
+#include "CsrGraph.h"
+
+/**
+ * @class AirportStats
+ * @brief Per-airport flight and destination counts of a CsrGraph, computed once and kept one column per statistic.
+ *
+ * Every column is indexed by airport id. The table is filled in a single pass over the routes, split between the
+ * threads of the shared pool, so every statistics query afterwards is a plain array read. A table restored by
+ * Snapshot::Load() reads its columns in place from the mapped file.
+ */
+class AirportStats {
+public:
+    /**
+     * @struct Columns
+     * @brief Every column of the table, as stored in a snapshot.
+     */
+    struct Columns {
+        Column<int> flightsOut;     ///< Flights out of each airport.
+        Column<int> airlines;       ///< Distinct airlines flying out of each airport.
+        Column<int> destinations;   ///< Distinct airports reached by a direct flight.
+        Column<int> cities;         ///< Distinct city names reached by a direct flight.
+        Column<int> countries;      ///< Distinct countries reached by a direct flight.
+        Column<int> flightsIn;      ///< Flights into each airport.
+    };
+
+    /**
+     * @brief Builds an empty table.
+     * @details Time complexity: O(1)
+     */
+    AirportStats();
+
+    /**
+     * @brief Computes the statistics of every airport of a graph.
+     * @param graph The graph; the table keeps its ids but no reference to it.
+     * @details Time complexity: O(V + F log D), where F is the number of flights and D the greatest number of flights
+     * out of an airport, divided between the threads of the shared pool.
+     */
+    explicit AirportStats(const CsrGraph& graph);
+
+    /**
+     * @brief Restores a table computed earlier, e.g. by a snapshot.
+     * @param columns The columns, all with one entry per airport.
+     * @details Time complexity: O(1)
+     */
+    explicit AirportStats(Columns columns);
+
+    /**
+     * @brief Gets the columns of the table, sharing their storage.
+     * @return The columns.
+     * @details Time complexity: O(1)
+     */
+    Columns getColumns() const;
+
+    /**
+     * @brief Number of flights out of an airport, counting each airline on a route.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getFlightsOut(int v) const { return flightsOut[v]; }
+
+    /**
+     * @brief Number of distinct airlines flying out of an airport.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getAirlines(int v) const { return airlines[v]; }
+
+    /**
+     * @brief Number of distinct airports reached by a direct flight.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getDestinations(int v) const { return destinations[v]; }
+
+    /**
+     * @brief Number of distinct city names reached by a direct flight.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getCities(int v) const { return cities[v]; }
+
+    /**
+     * @brief Number of distinct countries reached by a direct flight.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getCountries(int v) const { return countries[v]; }
+
+    /**
+     * @brief Number of flights into an airport, counting each airline on a route.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int getFlightsIn(int v) const { return flightsIn[v]; }
+
+private:
+    Column<int> flightsOut;
+    Column<int> airlines;
+    Column<int> destinations;
+    Column<int> cities;
+    Column<int> countries;
+    Column<int> flightsIn;
+};
+
+#endif //PROJETO_2_AIRPORTSTATS_H
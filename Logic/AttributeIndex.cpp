@@ -0,0 +1,104 @@
+#include "AttributeIndex.h"
+#include <algorithm>
+
+/**
+ * @brief Builds an empty index.
+ * @details Time complexity: O(1)
+ */
+AttributeIndex::AttributeIndex() : cityOffsets(1, 0), countryOffsets(1, 0), airlineOffsets(1, 0) {}
+
+/**
+ * @brief Indexes the airports and routes of a graph.
+ * @param graph The graph; the index keeps its ids but no reference to it.
+ * @details Time complexity: O(V + F + K), where F is the number of flights and K the number of interned keys.
+ */
+AttributeIndex::AttributeIndex(const CsrGraph& graph) {
+    int n = graph.getNumVertex();
+    std::vector<int> airports(n), cities(n), countries(n);
+    for (int v = 0; v < n; v++) {
+        airports[v] = v;
+        cities[v] = graph.getAirport(v).getCityId();
+        countries[v] = graph.getAirport(v).getCountryId();
+    }
+    group(cities, airports, cityOffsets, cityAirportIds);
+    group(countries, airports, countryOffsets, countryAirportIds);
+
+    std::vector<int> airlines, routes;
+    airlines.reserve(graph.getNumFlights());
+    routes.reserve(graph.getNumFlights());
+    for (int e = 0; e < (int) graph.getNumEdges(); e++) {
+        for (int i = graph.edgeAirlinesBegin(e); i < graph.edgeAirlinesEnd(e); i++) {
+            airlines.push_back(graph.flightAirline(i));
+            routes.push_back(e);
+        }
+    }
+    group(airlines, routes, airlineOffsets, airlineRouteIds);
+}
+
+/**
+ * @brief Groups values by key with a counting sort, keeping the order of the values within each key.
+ * @param keys The key of each value, non-negative.
+ * @param values The values.
+ * @param offsets Output; the values of key k end up in [offsets[k], offsets[k + 1]) of grouped.
+ * @param grouped Output, the values ordered by key.
+ * @details Time complexity: O(N + K), where N is the number of values and K the greatest key.
+ */
+void AttributeIndex::group(const std::vector<int>& keys, const std::vector<int>& values,
+                           std::vector<int>& offsets, std::vector<int>& grouped) {
+    int keyCount = keys.empty() ? 0 : *std::max_element(keys.begin(), keys.end()) + 1;
+    offsets.assign(keyCount + 1, 0);
+    for (int key : keys) {
+        offsets[key + 1]++;
+    }
+    for (int k = 0; k < keyCount; k++) {
+        offsets[k + 1] += offsets[k];
+    }
+    grouped.resize(values.size());
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < values.size(); i++) {
+        grouped[next[keys[i]]++] = values[i];
+    }
+}
+
+/**
+ * @brief Gets the values of a key grouped by group().
+ * @return The values; none for keys that were never seen.
+ * @details Time complexity: O(1)
+ */
+AttributeIndex::Range AttributeIndex::lookup(const std::vector<int>& offsets, const std::vector<int>& grouped,
+                                             int key) {
+    if (key < 0 || key + 1 >= (int) offsets.size()) {
+        return {nullptr, nullptr};
+    }
+    return {grouped.data() + offsets[key], grouped.data() + offsets[key + 1]};
+}
+
+/**
+ * @brief Gets the airports of every city with a name.
+ * @param cityId The id of the name in StringPool::cities(), or StringPool::NotFound.
+ * @return The airport ids, sorted.
+ * @details Time complexity: O(1)
+ */
+AttributeIndex::Range AttributeIndex::cityAirports(int cityId) const {
+    return lookup(cityOffsets, cityAirportIds, cityId);
+}
+
+/**
+ * @brief Gets the airports of a country.
+ * @param countryId The id of the country in StringPool::countries(), or StringPool::NotFound.
+ * @return The airport ids, sorted.
+ * @details Time complexity: O(1)
+ */
+AttributeIndex::Range AttributeIndex::countryAirports(int countryId) const {
+    return lookup(countryOffsets, countryAirportIds, countryId);
+}
+
+/**
+ * @brief Gets the routes an airline flies.
+ * @param airlineId The id of the airline in StringPool::airlineCodes(), or StringPool::NotFound.
+ * @return The route indices, sorted, once per flight of the airline.
+ * @details Time complexity: O(1)
+ */
+AttributeIndex::Range AttributeIndex::airlineRoutes(int airlineId) const {
+    return lookup(airlineOffsets, airlineRouteIds, airlineId);
+}
@@ -0,0 +1,82 @@
+#ifndef PROJETO_2_ATTRIBUTEINDEX_H
+#define PROJETO_2_ATTRIBUTEINDEX_H
+
+#include <cstddef>
+#include <vector>
+#include "CsrGraph.h"
+
+/**
+ * @class AttributeIndex
+ * @brief Secondary indexes of a CsrGraph: the airports of each city and country, and the routes of each airline.
+ *
+ * Each index is grouped like the graph itself: the entries of key k are [offsets[k], offsets[k + 1]) of one array,
+ * where k is the id of the city, country or airline in its StringPool. Cities are keyed by name alone, so the airports
+ * of cities sharing a name in different countries are listed together, sorted by id.
+ */
+class AttributeIndex {
+public:
+    /**
+     * @struct Range
+     * @brief The entries of one key, as a pair of pointers into the index.
+     */
+    struct Range {
+        const int* first;   ///< The first entry.
+        const int* last;    ///< One past the last entry.
+
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    /**
+     * @brief Builds an empty index.
+     * @details Time complexity: O(1)
+     */
+    AttributeIndex();
+
+    /**
+     * @brief Indexes the airports and routes of a graph.
+     * @param graph The graph; the index keeps its ids but no reference to it.
+     * @details Time complexity: O(V + F + K), where F is the number of flights and K the number of interned keys.
+     */
+    explicit AttributeIndex(const CsrGraph& graph);
+
+    /**
+     * @brief Gets the airports of every city with a name.
+     * @param cityId The id of the name in StringPool::cities(), or StringPool::NotFound.
+     * @return The airport ids, sorted.
+     * @details Time complexity: O(1)
+     */
+    Range cityAirports(int cityId) const;
+
+    /**
+     * @brief Gets the airports of a country.
+     * @param countryId The id of the country in StringPool::countries(), or StringPool::NotFound.
+     * @return The airport ids, sorted.
+     * @details Time complexity: O(1)
+     */
+    Range countryAirports(int countryId) const;
+
+    /**
+     * @brief Gets the routes an airline flies.
+     * @param airlineId The id of the airline in StringPool::airlineCodes(), or StringPool::NotFound.
+     * @return The route indices, sorted, once per flight of the airline.
+     * @details Time complexity: O(1)
+     */
+    Range airlineRoutes(int airlineId) const;
+
+private:
+    std::vector<int> cityOffsets;
+    std::vector<int> cityAirportIds;
+    std::vector<int> countryOffsets;
+    std::vector<int> countryAirportIds;
+    std::vector<int> airlineOffsets;
+    std::vector<int> airlineRouteIds;
+
+    static void group(const std::vector<int>& keys, const std::vector<int>& values,
+                      std::vector<int>& offsets, std::vector<int>& grouped);
+    static Range lookup(const std::vector<int>& offsets, const std::vector<int>& grouped, int key);
+};
+
+#endif //PROJETO_2_ATTRIBUTEINDEX_H
@@ -0,0 +1,61 @@
+#ifndef PROJETO_2_COLUMN_H
+#define PROJETO_2_COLUMN_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Column
+ * @brief Immutable array of values that either owns its storage or reads it in place from a shared buffer.
+ *
+ * The indexes build their arrays in vectors and hand them to a column, while Snapshot::Load() points columns straight
+ * at the sections of a memory-mapped file. Copies share the storage, which stays alive until the last copy is gone.
+ * @tparam T The type of the values.
+ */
+template <class T>
+class Column {
+public:
+    /**
+     * @brief Builds an empty column.
+     * @details Time complexity: O(1)
+     */
+    Column() : first(nullptr), count(0) {}
+
+    /**
+     * @brief Takes over the values of a vector.
+     * @param values The values.
+     * @details Time complexity: O(1)
+     */
+    explicit Column(std::vector<T> values) {
+        auto owned = std::make_shared<const std::vector<T>>(std::move(values));
+        first = owned->data();
+        count = owned->size();
+        owner = std::move(owned);
+    }
+
+    /**
+     * @brief Reads values in place from a buffer owned by another object.
+     * @param data The first value.
+     * @param size The number of values.
+     * @param keeper The owner of the buffer, kept alive by the column.
+     * @details Time complexity: O(1)
+     */
+    Column(const T* data, size_t size, std::shared_ptr<const void> keeper)
+            : first(data), count(size), owner(std::move(keeper)) {}
+
+    const T& operator[](size_t i) const { return first[i]; }
+    const T* data() const { return first; }
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    const T* first;
+    size_t count;
+    std::shared_ptr<const void> owner;
+};
+
+#endif //PROJETO_2_COLUMN_H
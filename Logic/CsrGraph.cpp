@@ -0,0 +1,791 @@
+#include "CsrGraph.h"
+#include "Haversine.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+/**
+ * @brief Default constructor, builds an empty graph.
+ * @details Time complexity: O(1)
+ */
+CsrGraph::CsrGraph() : offsets(std::vector<int>(1, 0)), routeAirlineOffsets(std::vector<int>(1, 0)),
+                       inOffsets(std::vector<int>(1, 0)) {}
+
+// The idle contexts of the calling thread; a lease destroyed on another thread hands its context to that thread
+static std::vector<std::unique_ptr<CsrGraph::QueryContext>>& idleContexts() {
+    static thread_local std::vector<std::unique_ptr<CsrGraph::QueryContext>> idle;
+    return idle;
+}
+
+/**
+ * @brief Takes an idle context of the calling thread, or creates one when they are all leased.
+ * @details Time complexity: O(1), besides allocating the context the first time.
+ */
+CsrGraph::ContextLease::ContextLease() {
+    std::vector<std::unique_ptr<QueryContext>>& idle = idleContexts();
+    if (idle.empty()) {
+        context = std::make_unique<QueryContext>();
+    } else {
+        context = std::move(idle.back());
+        idle.pop_back();
+    }
+}
+
+/**
+ * @brief Hands the context back to the pool of the calling thread.
+ * @details Time complexity: O(1) amortised
+ */
+CsrGraph::ContextLease::~ContextLease() {
+    if (context) {
+        idleContexts().push_back(std::move(context));
+    }
+}
+
+/**
+ * @brief Hands the current context back and takes over the context of another lease.
+ * @param other The lease to take over; it is left empty.
+ * @return This lease.
+ * @details Time complexity: O(1) amortised
+ */
+CsrGraph::ContextLease& CsrGraph::ContextLease::operator=(ContextLease&& other) noexcept {
+    if (this != &other) {
+        if (context) {
+            idleContexts().push_back(std::move(context));
+        }
+        context = std::move(other.context);
+    }
+    return *this;
+}
+
+/**
+ * @brief Builds the CSR form of a loaded graph.
+ * @param g The graph to copy.
+ * @details Time complexity: O(V + F log D), where V is the number of airports, F the number of flights and D the
+ * greatest number of flights out of an airport.
+ */
+CsrGraph::CsrGraph(const Graph<Airport>& g) {
+    const vector<Vertex<Airport>*> vertexSet = g.getVertexSet();
+    std::unordered_map<const Vertex<Airport>*, int> vertexToId;
+    vertexToId.reserve(vertexSet.size());
+    for (auto v : vertexSet) {
+        int id = (int) vertexToId.size();
+        vertexToId[v] = id;
+    }
+    airports.reserve(vertexSet.size());
+    for (auto v : vertexSet) {
+        airports.push_back(v->getInfo());
+    }
+    indexAirports();
+
+    std::vector<double> x(airports.size()), y(airports.size()), z(airports.size());
+    for (size_t v = 0; v < airports.size(); v++) {
+        double coords[3];
+        Haversine::unitVector(airports[v].getLatitude(), airports[v].getLongitude(), coords);
+        x[v] = coords[0];
+        y[v] = coords[1];
+        z[v] = coords[2];
+    }
+
+    // Groups each airport's flights by destination, so the parallel flights of different airlines become one route
+    std::vector<std::pair<int, const Edge<Airport>*>> flights;
+    std::vector<int> out, dests, airlineOffsets, airlines;
+    std::vector<double> lengths;
+    out.reserve(vertexSet.size() + 1);
+    out.push_back(0);
+    airlineOffsets.push_back(0);
+    for (auto v : vertexSet) {
+        flights.clear();
+        for (const Edge<Airport>& e : v->getAdj()) {
+            flights.emplace_back(vertexToId[e.getDest()], &e);
+        }
+        std::stable_sort(flights.begin(), flights.end(),
+                         [](const std::pair<int, const Edge<Airport>*>& a, const std::pair<int, const Edge<Airport>*>& b) {
+            return a.first < b.first;
+        });
+
+        for (size_t i = 0; i < flights.size(); i++) {
+            if (i == 0 || flights[i].first != flights[i - 1].first) {
+                if (i != 0) {
+                    airlineOffsets.push_back((int) airlines.size());
+                }
+                dests.push_back(flights[i].first);
+                lengths.push_back(flights[i].second->getweight());
+            }
+            airlines.push_back(flights[i].second->getAirlineId());
+        }
+        if (!flights.empty()) {
+            airlineOffsets.push_back((int) airlines.size());
+        }
+        out.push_back((int) dests.size());
+    }
+
+    size_t numRoutes = dests.size();
+    std::vector<int> in(vertexSet.size() + 1, 0);
+    for (int w : dests) {
+        in[w + 1]++;
+    }
+    for (size_t v = 0; v < vertexSet.size(); v++) {
+        in[v + 1] += in[v];
+    }
+    std::vector<int> sources(numRoutes), routes(numRoutes);
+    std::vector<int> next(in.begin(), in.end() - 1);
+    for (int v = 0; v < (int) vertexSet.size(); v++) {
+        for (int e = out[v]; e < out[v + 1]; e++) {
+            int slot = next[dests[e]]++;
+            sources[slot] = v;
+            routes[slot] = e;
+        }
+    }
+
+    unitX = Column<double>(std::move(x));
+    unitY = Column<double>(std::move(y));
+    unitZ = Column<double>(std::move(z));
+    offsets = Column<int>(std::move(out));
+    destinations = Column<int>(std::move(dests));
+    weights = Column<double>(std::move(lengths));
+    routeAirlineOffsets = Column<int>(std::move(airlineOffsets));
+    routeAirlines = Column<int>(std::move(airlines));
+    inOffsets = Column<int>(std::move(in));
+    inSources = Column<int>(std::move(sources));
+    inRoutes = Column<int>(std::move(routes));
+}
+
+/**
+ * @brief Restores a graph from arrays built earlier, e.g. by a snapshot.
+ * @param airports The airports, in the order of their ids.
+ * @param arrays The arrays, used as they are; Snapshot::Load() checks that they are consistent.
+ * @details Time complexity: O(V), where V is the number of airports.
+ */
+CsrGraph::CsrGraph(std::vector<Airport> airports, Arrays arrays)
+        : airports(std::move(airports)), unitX(std::move(arrays.unitX)), unitY(std::move(arrays.unitY)), unitZ(std::move(arrays.unitZ)),
+          offsets(std::move(arrays.offsets)), destinations(std::move(arrays.destinations)),
+          weights(std::move(arrays.weights)), routeAirlineOffsets(std::move(arrays.routeAirlineOffsets)),
+          routeAirlines(std::move(arrays.routeAirlines)), inOffsets(std::move(arrays.inOffsets)),
+          inSources(std::move(arrays.inSources)), inRoutes(std::move(arrays.inRoutes)) {
+    indexAirports();
+}
+
+/**
+ * @brief Gets the arrays of the graph, sharing their storage.
+ * @return The arrays.
+ * @details Time complexity: O(1)
+ */
+CsrGraph::Arrays CsrGraph::getArrays() const {
+    return {offsets, destinations, weights, routeAirlineOffsets, routeAirlines, inOffsets, inSources, inRoutes,
+            unitX, unitY, unitZ};
+}
+
+/**
+ * @brief Indexes the airports by code.
+ * @details Time complexity: O(V), where V is the number of airports.
+ */
+void CsrGraph::indexAirports() {
+    codeToId.reserve(airports.size());
+    for (int id = 0; id < (int) airports.size(); id++) {
+        codeToId[airports[id].getCodeId()] = id;
+    }
+}
+
+/**
+ * @brief Gets the number of airports.
+ * @return The number of vertices.
+ * @details Time complexity: O(1)
+ */
+int CsrGraph::getNumVertex() const {
+    return (int) airports.size();
+}
+
+/**
+ * @brief Gets the number of routes, the airport pairs joined by at least one flight.
+ * @return The number of edges.
+ * @details Time complexity: O(1)
+ */
+size_t CsrGraph::getNumEdges() const {
+    return destinations.size();
+}
+
+/**
+ * @brief Gets the number of flights, counting each airline on a route.
+ * @return The number of flights.
+ * @details Time complexity: O(1)
+ */
+size_t CsrGraph::getNumFlights() const {
+    return routeAirlines.size();
+}
+
+/**
+ * @brief Finds the id of the airport with the given code.
+ * @param code The airport code.
+ * @return The airport id, or -1 if there is no such airport.
+ * @details Time complexity: O(1) on average
+ */
+int CsrGraph::findVertex(const std::string& code) const {
+    auto it = codeToId.find(StringPool::airportCodes().find(code));
+    if (it == codeToId.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Gets the great-circle distance between two airports from their unit vectors.
+ * @param u The first airport id.
+ * @param v The second airport id.
+ * @return The distance, in kilometres.
+ * @details Uses atan2(|u x v|, u.v), which stays accurate for nearby and for antipodal airports alike.
+ * Time complexity: O(1)
+ */
+double CsrGraph::greatCircleDistance(int u, int v) const {
+    double cx = unitY[u] * unitZ[v] - unitZ[u] * unitY[v];
+    double cy = unitZ[u] * unitX[v] - unitX[u] * unitZ[v];
+    double cz = unitX[u] * unitY[v] - unitY[u] * unitX[v];
+    double dot = unitX[u] * unitX[v] + unitY[u] * unitY[v] + unitZ[u] * unitZ[v];
+    return Haversine::EarthRadius * atan2(sqrt(cx * cx + cy * cy + cz * cz), dot);
+}
+
+/**
+ * @brief Gets the airport stored under an id.
+ * @param id The airport id.
+ * @return The airport.
+ * @details Time complexity: O(1)
+ */
+const Airport& CsrGraph::getAirport(int id) const {
+    return airports[id];
+}
+
+/**
+ * @brief Gets the airline code stored under an airline id.
+ * @param airlineId The airline id.
+ * @return The airline code.
+ * @details Time complexity: O(1)
+ */
+const std::string& CsrGraph::getAirlineCode(int airlineId) const {
+    return StringPool::airlineCodes().get(airlineId);
+}
+
+/**
+ * @brief Breadth-first search computing the number of flights from a source to every airport.
+ * @param source The source airport id.
+ * @param dist Output, reset to V slots; dist[v] is the hop distance to v, or -1 if v is unreachable.
+ * @param queue Output, the airports reached in the order they were reached, so the last one is the farthest.
+ * @return The greatest hop distance reached (the eccentricity of the source).
+ * @details Time complexity: O(R + E_R), where R is the number of airports reached and E_R their routes.
+ */
+int CsrGraph::bfs(int source, StampedArray<int>& dist, std::vector<int>& queue) const {
+    dist.reset(airports.size());
+    queue.clear();
+
+    queue.push_back(source);
+    dist.set(source, 0);
+    int eccentricity = 0;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        int next = dist[v] + 1;
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int w = destinations[e];
+            if (dist[w] < 0) {
+                dist.set(w, next);
+                eccentricity = next;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    return eccentricity;
+}
+
+/**
+ * @brief Breadth-first search over the incoming routes, computing the number of flights from every airport to a target.
+ * @param target The target airport id.
+ * @param dist Output, reset to V slots; dist[v] is the hop distance from v, or -1 if v cannot reach the target.
+ * @param queue Output, the airports reached in the order they were reached, so the last one is the farthest.
+ * @return The greatest hop distance reached (the backward eccentricity of the target).
+ * @details Time complexity: O(R + E_R), where R is the number of airports reached and E_R their routes.
+ */
+int CsrGraph::reverseBfs(int target, StampedArray<int>& dist, std::vector<int>& queue) const {
+    dist.reset(airports.size());
+    queue.clear();
+
+    queue.push_back(target);
+    dist.set(target, 0);
+    int eccentricity = 0;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        int next = dist[v] + 1;
+        for (int e = inOffsets[v]; e < inOffsets[v + 1]; e++) {
+            int w = inSources[e];
+            if (dist[w] < 0) {
+                dist.set(w, next);
+                eccentricity = next;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    return eccentricity;
+}
+
+/**
+ * @brief Gets the position of the lowest set bit of a word.
+ * @param bits A non-zero word.
+ * @return The index of its lowest set bit.
+ * @details Time complexity: O(1)
+ */
+static int lowestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Starts the bit-parallel searches of a batch of sources.
+ * @param buffers The buffers of the batch.
+ * @param first The id of the first source; bit i stands for source first + i.
+ * @param count The number of sources, at most 64.
+ * @details Time complexity: O(V)
+ */
+void CsrGraph::startBatch(SourceBatchBuffers& buffers, int first, int count) const {
+    int n = getNumVertex();
+    buffers.seen.assign(n, 0);
+    buffers.frontier.assign(n, 0);
+    buffers.next.resize(n);
+    for (int i = 0; i < count; i++) {
+        buffers.seen[first + i] = buffers.frontier[first + i] = uint64_t(1) << i;
+    }
+}
+
+/**
+ * @brief Advances every search of a batch by one level.
+ * @param buffers The buffers of the batch.
+ * @return Whether any search reached a new airport; if so the frontier now holds, for every airport, the sources that
+ * reached it on this level, and otherwise it still holds the last level.
+ * @details Time complexity: O(V + E)
+ */
+bool CsrGraph::advanceBatch(SourceBatchBuffers& buffers) const {
+    int n = getNumVertex();
+    std::fill(buffers.next.begin(), buffers.next.end(), 0);
+    for (int v = 0; v < n; v++) {
+        uint64_t bits = buffers.frontier[v];
+        if (bits) {
+            for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+                buffers.next[destinations[e]] |= bits;
+            }
+        }
+    }
+
+    bool advanced = false;
+    for (int w = 0; w < n; w++) {
+        uint64_t bits = buffers.next[w] & ~buffers.seen[w];
+        buffers.next[w] = bits;
+        if (bits) {
+            advanced = true;
+            buffers.seen[w] |= bits;
+        }
+    }
+    if (advanced) {
+        std::swap(buffers.frontier, buffers.next);
+    }
+    return advanced;
+}
+
+/**
+ * @brief Lists the (source, target) pairs of a batch on its current frontier.
+ * @param buffers The buffers of the batch.
+ * @param first The id of the first source of the batch.
+ * @param pairs Output, the pairs are appended to it.
+ * @details Time complexity: O(V + P), where P is the number of pairs listed.
+ */
+void CsrGraph::frontierPairs(const SourceBatchBuffers& buffers, int first, std::vector<std::pair<int, int>>& pairs) const {
+    for (int w = 0; w < getNumVertex(); w++) {
+        for (uint64_t bits = buffers.frontier[w]; bits; bits &= bits - 1) {
+            pairs.emplace_back(first + lowestBit(bits), w);
+        }
+    }
+}
+
+/**
+ * @brief Runs a BFS from every airport, 64 sources at a time.
+ * @return The eccentricities, hop histograms and farthest pairs of every airport.
+ * @details Time complexity: O(V / 64 * D * (V + E) + P), where D is the diameter and P the number of connected pairs.
+ */
+CsrGraph::HopSummary CsrGraph::allSourcesBfs() const {
+    int n = getNumVertex();
+    HopSummary summary;
+    summary.eccentricity.assign(n, 0);
+    summary.farthest.resize(n);
+    summary.reachable.assign(n, 0);
+    summary.histogram.resize(n);
+
+    std::mutex mutex;
+    int batches = (n + batchSize - 1) / batchSize;
+    ThreadPool::getShared().parallelFor(batches, [&](size_t batch) {
+        ContextLease context;
+        SourceBatchBuffers& buffers = context->batch;
+        int first = (int) batch * batchSize;
+        int count = std::min(batchSize, n - first);
+        startBatch(buffers, first, count);
+        for (int i = first; i < first + count; i++) {
+            summary.farthest[i] = i;
+            summary.histogram[i].assign(1, 1);
+        }
+
+        int level = 0;
+        while (advanceBatch(buffers)) {
+            level++;
+            for (int w = 0; w < n; w++) {
+                for (uint64_t bits = buffers.frontier[w]; bits; bits &= bits - 1) {
+                    int source = first + lowestBit(bits);
+                    summary.histogram[source].resize(level + 1, 0);
+                    summary.histogram[source][level]++;
+                    summary.farthest[source] = w;
+                }
+            }
+        }
+
+        for (int i = first; i < first + count; i++) {
+            summary.eccentricity[i] = (int) summary.histogram[i].size() - 1;
+            summary.reachable[i] = std::accumulate(summary.histogram[i].begin(), summary.histogram[i].end(), 0) - 1;
+        }
+
+        // The frontier still holds the airports first reached on the batch's last level.
+        std::vector<std::pair<int, int>> pairs;
+        if (level > 0) {
+            frontierPairs(buffers, first, pairs);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (level > summary.diameter) {
+            summary.diameter = level;
+            summary.farthestPairs.clear();
+        }
+        if (level == summary.diameter) {
+            summary.farthestPairs.insert(summary.farthestPairs.end(), pairs.begin(), pairs.end());
+        }
+    });
+
+    std::sort(summary.farthestPairs.begin(), summary.farthestPairs.end());
+    return summary;
+}
+
+/**
+ * @brief Lists every pair of airports whose shortest route takes a given number of flights.
+ * @param hops The number of flights.
+ * @return The (source, target) pairs, sorted by source and then target.
+ * @details Time complexity: O(V / 64 * hops * (V + E) + P), where P is the number of pairs.
+ */
+std::vector<std::pair<int, int>> CsrGraph::pairsAtDistance(int hops) const {
+    std::vector<std::pair<int, int>> res;
+    int n = getNumVertex();
+    if (hops <= 0) {
+        return res;
+    }
+
+    std::mutex mutex;
+    int batches = (n + batchSize - 1) / batchSize;
+    ThreadPool::getShared().parallelFor(batches, [&](size_t batch) {
+        ContextLease context;
+        SourceBatchBuffers& buffers = context->batch;
+        int first = (int) batch * batchSize;
+        startBatch(buffers, first, std::min(batchSize, n - first));
+
+        int level = 0;
+        while (level < hops && advanceBatch(buffers)) {
+            level++;
+        }
+        if (level < hops) {
+            return;
+        }
+        std::vector<std::pair<int, int>> pairs;
+        frontierPairs(buffers, first, pairs);
+        std::lock_guard<std::mutex> lock(mutex);
+        res.insert(res.end(), pairs.begin(), pairs.end());
+    });
+
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * @brief Dijkstra search for the route with the fewest kilometres from any source to any target.
+ * @param sources The ids of the origin airports, all starting at distance 0.
+ * @param targets The ids of the destination airports; the search stops when the first of them is settled.
+ * @param filter The airlines whose flights may be taken; a route is usable if any of its airlines is allowed.
+ * @param buffers Scratch state reused between calls; afterwards it holds the distances and parents of the search.
+ * @return The id of the target reached, or -1 if no target can be reached.
+ * @details Time complexity: O((V + E) log E). Stale heap entries are skipped when popped instead of being
+ * decreased in place.
+ */
+int CsrGraph::dijkstra(const std::vector<int>& sources, const std::vector<int>& targets,
+                       const AirlineFilter& filter, SearchBuffers& buffers) const {
+    return shortestRoute(sources, targets, filter, false, buffers);
+}
+
+/**
+ * @brief A* search for the route with the fewest kilometres from any source to any target.
+ * @details Same contract as dijkstra(), but airports are ordered by their distance plus the great-circle distance
+ * to the nearest target, picked by squared chord. Time complexity: O((V + E) log E + V * T), where T is the number of
+ * targets.
+ */
+int CsrGraph::aStar(const std::vector<int>& sources, const std::vector<int>& targets,
+                    const AirlineFilter& filter, SearchBuffers& buffers) const {
+    return shortestRoute(sources, targets, filter, true, buffers);
+}
+
+// Shared body of dijkstra and aStar; without the estimate every key is just the distance from the sources
+int CsrGraph::shortestRoute(const std::vector<int>& sources, const std::vector<int>& targets,
+                            const AirlineFilter& filter, bool useEstimate, SearchBuffers& buffers) const {
+    const double infinity = std::numeric_limits<double>::infinity();
+    const std::greater<std::pair<double, int>> minFirst;
+
+    // Only the stamped arrays need clearing; parent and hops are written whenever dist is
+    buffers.dist.reset(airports.size());
+    buffers.parent.resize(airports.size());
+    buffers.hops.resize(airports.size());
+    buffers.isTarget.reset(airports.size());
+    if (useEstimate) {
+        buffers.estimate.reset(airports.size());
+    }
+    buffers.heap.clear();
+    buffers.settled = 0;
+
+    // The distance to the nearest target by squared chord, lowered by the rounding error of the weights so that it
+    // never overestimates
+    auto estimate = [&](int v) {
+        if (!useEstimate) {
+            return 0.0;
+        }
+        if (buffers.estimate[v] < 0) {
+            int nearest = -1;
+            double best = infinity;
+            for (int t : targets) {
+                double chord = squaredChord(v, t);
+                if (chord < best) {
+                    best = chord;
+                    nearest = t;
+                }
+            }
+            buffers.estimate.set(v, nearest < 0 ? 0 : std::max(0.0, greatCircleDistance(v, nearest) - Haversine::MaxError));
+        }
+        return buffers.estimate[v];
+    };
+
+    for (int t : targets) {
+        buffers.isTarget.set(t, true);
+    }
+    for (int s : sources) {
+        if (buffers.dist[s] != 0) {
+            buffers.dist.set(s, 0);
+            buffers.parent[s] = -1;
+            buffers.hops[s] = 0;
+            buffers.heap.emplace_back(estimate(s), s);
+        }
+    }
+    std::make_heap(buffers.heap.begin(), buffers.heap.end(), minFirst);
+
+    while (!buffers.heap.empty()) {
+        std::pop_heap(buffers.heap.begin(), buffers.heap.end(), minFirst);
+        double key = buffers.heap.back().first;
+        int v = buffers.heap.back().second;
+        buffers.heap.pop_back();
+
+        double d = buffers.dist[v];
+        if (key > d + estimate(v)) {
+            continue;
+        }
+        buffers.settled++;
+        if (buffers.isTarget[v]) {
+            return v;
+        }
+
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            if (!edgeAllowed(e, filter)) {
+                continue;
+            }
+            int w = destinations[e];
+            double next = d + weights[e];
+            if (next < buffers.dist[w]) {
+                buffers.dist.set(w, next);
+                buffers.parent[w] = v;
+                buffers.hops[w] = buffers.hops[v] + 1;
+                buffers.heap.emplace_back(next + estimate(w), w);
+                std::push_heap(buffers.heap.begin(), buffers.heap.end(), minFirst);
+            }
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Rebuilds the route found by the last search.
+ * @param target The airport returned by the search.
+ * @param buffers The buffers filled by the search.
+ * @return The airport ids of the route, from the source to the target.
+ * @details Time complexity: O(L), where L is the number of flights on the route.
+ */
+std::vector<int> CsrGraph::route(int target, const SearchBuffers& buffers) const {
+    std::vector<int> res;
+    for (int v = target; v != -1; v = buffers.parent[v]) {
+        res.push_back(v);
+    }
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * @brief Calculates the exact diameter of the graph by bounding eccentricities (iFUB for directed graphs).
+ * @return The diameter and a witness pair of airports.
+ * @details Time complexity: O(k * (V + E)), where k is the number of searches; O(V * (V + E)) in the worst case.
+ */
+CsrGraph::Diameter CsrGraph::findDiameter() const {
+    Diameter best;
+    int n = getNumVertex();
+    if (n == 0) {
+        return best;
+    }
+
+    int root = 0;
+    for (int v = 1; v < n; v++) {
+        if (offsets[v + 1] - offsets[v] + inOffsets[v + 1] - inOffsets[v] >
+            offsets[root + 1] - offsets[root] + inOffsets[root + 1] - inOffsets[root]) {
+            root = v;
+        }
+    }
+
+    std::mutex mutex;
+    auto record = [&](int source, bool backward, int eccentricity, const std::vector<int>& reached) {
+        int farthest = reached.back();
+        std::lock_guard<std::mutex> lock(mutex);
+        best.bfsRuns++;
+        if (eccentricity > best.hops) {
+            best.hops = eccentricity;
+            best.from = backward ? farthest : source;
+            best.to = backward ? source : farthest;
+        }
+    };
+    auto sweep = [&](const std::vector<int>& sources, bool backward) {
+        ThreadPool::getShared().parallelFor(sources.size(), [&](size_t i) {
+            ContextLease context;
+            int eccentricity = backward ? reverseBfs(sources[i], context->dist, context->queue)
+                                        : bfs(sources[i], context->dist, context->queue);
+            record(sources[i], backward, eccentricity, context->queue);
+        });
+    };
+
+    best.from = best.to = root;
+    StampedArray<int> forward(-1), backward(-1);
+    std::vector<int> queue;
+    record(root, false, bfs(root, forward, queue), queue);
+    record(root, true, reverseBfs(root, backward, queue), queue);
+
+    // Pairs that do not pass through the root are not bounded by it, so their ends are searched directly.
+    std::vector<int> notReachingRoot, notReachedFromRoot;
+    int levels = 0;
+    for (int v = 0; v < n; v++) {
+        if (backward[v] < 0) notReachingRoot.push_back(v);
+        if (forward[v] < 0) notReachedFromRoot.push_back(v);
+        levels = std::max(levels, std::max(forward[v], backward[v]));
+    }
+    sweep(notReachingRoot, false);
+    sweep(notReachedFromRoot, true);
+
+    std::vector<std::vector<int>> forwardLevels(levels + 1), backwardLevels(levels + 1);
+    for (int v = 0; v < n; v++) {
+        if (forward[v] >= 0) forwardLevels[forward[v]].push_back(v);
+        if (backward[v] >= 0) backwardLevels[backward[v]].push_back(v);
+    }
+
+    // Once levels > i are done, every unseen pair (x, y) has d(x, y) <= d(x, root) + d(root, y) <= 2 * i.
+    for (int i = levels; i > 0 && best.hops < 2 * i; i--) {
+        sweep(backwardLevels[i], false);
+        sweep(forwardLevels[i], true);
+    }
+
+    return best;
+}
+
+/**
+ * @brief Calculates the diameter of the graph.
+ * @return The greatest hop distance between two airports connected by some route.
+ * @details Time complexity: see findDiameter().
+ */
+int CsrGraph::calculateDiameter() const {
+    return findDiameter().hops;
+}
+
+/**
+ * @brief Finds the articulation points of the graph.
+ * @return The set of articulation airports.
+ * @details Time complexity: O(V + E)
+ */
+std::unordered_set<Airport> CsrGraph::findArticulationPoints() const {
+    std::unordered_set<Airport> articulationPoints;
+    std::vector<int> num(airports.size(), 0);
+    std::vector<int> low(airports.size(), 0);
+    std::vector<char> processing(airports.size(), false);
+    std::vector<int> stack;
+    int index = 1;
+
+    for (int v = 0; v < getNumVertex(); v++) {
+        if (num[v] == 0) {
+            dfsArticulationPoints(v, num, low, processing, stack, index, articulationPoints);
+        }
+    }
+
+    return articulationPoints;
+}
+
+// Helper function for findArticulationPoints, a vertex is visited once it has been numbered
+void CsrGraph::dfsArticulationPoints(int v, std::vector<int>& num, std::vector<int>& low, std::vector<char>& processing,
+                                     std::vector<int>& stack, int& index, std::unordered_set<Airport>& articPoints) const {
+    num[v] = index;
+    low[v] = index;
+    index++;
+
+    stack.push_back(v);
+    processing[v] = true;
+
+    int children = 0;
+    bool isArticulationPoint = false;
+
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+        int w = destinations[e];
+        if (num[w] == 0) {
+            children++;
+            dfsArticulationPoints(w, num, low, processing, stack, index, articPoints);
+            low[v] = std::min(low[v], low[w]);
+
+            if (low[w] >= num[v]) {
+                isArticulationPoint = true;
+            }
+        } else if (processing[w]) {
+            low[v] = std::min(low[v], num[w]);
+        }
+    }
+
+    if ((num[v] == low[v] && children > 1) || (num[v] != low[v] && isArticulationPoint)) {
+        articPoints.insert(airports[v]);
+
+        while (!stack.empty()) {
+            int popped = stack.back();
+            stack.pop_back();
+            processing[popped] = false;
+
+            if (popped == v) {
+                break;
+            }
+        }
+    }
+}
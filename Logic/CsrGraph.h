@@ -0,0 +1,886 @@
+#ifndef PROJETO_2_CSRGRAPH_H
+#define PROJETO_2_CSRGRAPH_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "Graph.h"
+#include "Airport.h"
+#include "AirlineFilter.h"
+#include "Column.h"
+#include "StampedArray.h"
+
+/**
+ * @class CsrGraph
+ * @brief Immutable compressed sparse row (CSR) copy of a loaded flight graph.
+ *
+ * Airports are numbered 0..V-1 in the order of the source graph's vertex set. The parallel flights of different
+ * airlines between two airports are merged into one route, and the outgoing routes of airport v are the entries
+ * [offsets[v], offsets[v + 1]) of the destination and weight arrays, sorted by destination; the airlines of route e
+ * are the entries [routeAirlineOffsets[e], routeAirlineOffsets[e + 1]) of routeAirlines. The incoming routes are kept
+ * the same way in a reverse copy, sorted by origin. Each airport's position is also kept as a unit vector in three
+ * coordinate arrays, so distances can be compared without trigonometry. Traversals work on integer ids and contiguous
+ * arrays instead of following Vertex and Edge pointers across the heap. The arrays are Columns, so a graph restored by
+ * Snapshot::Load() reads them in place from the mapped file.
+ */
+class CsrGraph {
+public:
+    /**
+     * @struct Arrays
+     * @brief Every array of the graph besides the airports themselves, as stored in a snapshot.
+     */
+    struct Arrays {
+        Column<int> offsets;                ///< First outgoing route of each airport, plus the route count.
+        Column<int> destinations;           ///< Destination airport of each route.
+        Column<double> weights;             ///< Length of each route, in kilometres.
+        Column<int> routeAirlineOffsets;    ///< First airline of each route, plus the flight count.
+        Column<int> routeAirlines;          ///< Interned airline id of each flight.
+        Column<int> inOffsets;              ///< First incoming route of each airport, plus the route count.
+        Column<int> inSources;              ///< Origin airport of each incoming route.
+        Column<int> inRoutes;               ///< Outgoing route index of each incoming route.
+        Column<double> unitX;               ///< x coordinate of each airport on the unit sphere.
+        Column<double> unitY;               ///< y coordinate of each airport on the unit sphere.
+        Column<double> unitZ;               ///< z coordinate of each airport on the unit sphere.
+    };
+
+    /**
+     * @struct SearchBuffers
+     * @brief Scratch state of a weighted search, kept by the caller and reused between queries so that a search only
+     * allocates the first time it runs.
+     *
+     * The per-airport arrays are stamped or only read for airports the search reached, so starting a search does not
+     * touch the whole graph.
+     */
+    struct SearchBuffers {
+        StampedArray<double> dist{std::numeric_limits<double>::infinity()};    ///< Kilometres from the nearest source, or infinity.
+        std::vector<int> parent;                    ///< Previous airport on the best route, or -1 for sources; only set where dist is.
+        std::vector<int> hops;                      ///< Number of flights on the best route; only set where dist is.
+        StampedArray<char> isTarget{false};         ///< Marks the destination airports of the current query.
+        StampedArray<double> estimate{-1};          ///< Cached A* lower bound to the nearest target, or -1.
+        std::vector<std::pair<double, int>> heap;   ///< Binary min-heap of (kilometres + estimate, airport).
+        int settled = 0;                            ///< Number of airports settled by the last search.
+    };
+
+    /**
+     * @struct HopBuffers
+     * @brief Scratch state of a bidirectional breadth-first search, reused between queries like SearchBuffers.
+     *
+     * The distances are stamped, so starting a search costs nothing however many airports the graph has.
+     */
+    struct HopBuffers {
+        StampedArray<int> forwardDist{-1};  ///< Flights from the source, or -1 if not reached from that side.
+        StampedArray<int> backwardDist{-1}; ///< Flights to the target, or -1 if not reached from that side.
+        std::vector<int> forwardFrontier;   ///< Airports of the current forward level.
+        std::vector<int> backwardFrontier;  ///< Airports of the current backward level.
+        std::vector<int> nextFrontier;      ///< The level being built.
+        std::vector<std::pair<int, int>> meetings;  ///< Flights (from, to) where the two sides join on a shortest route.
+    };
+
+    /**
+     * @struct LevelBuffers
+     * @brief Scratch state of a multi-source breadth-first search, reused between queries like SearchBuffers.
+     *
+     * The search only labels airports with their level; the parents of an airport at level L are the origins of its
+     * allowed incoming flights at level L - 1, so the whole minimum-hop DAG is read back from the reverse CSR.
+     */
+    struct LevelBuffers {
+        StampedArray<int> level{-1};        ///< Flights from the nearest source, or -1 if not reached.
+        std::vector<int> frontier;          ///< Airports of the current level.
+        std::vector<int> nextFrontier;      ///< The level being built.
+        std::vector<int> reached;           ///< Targets on the first level that reached any target.
+    };
+
+    /**
+     * @struct SourceBatchBuffers
+     * @brief Scratch state of a bit-parallel search, where bit i of every word belongs to the i-th source of a batch.
+     */
+    struct SourceBatchBuffers {
+        std::vector<uint64_t> seen;         ///< Sources that have reached each airport.
+        std::vector<uint64_t> frontier;     ///< Sources that reached each airport on the current level.
+        std::vector<uint64_t> next;         ///< The level being built.
+    };
+
+    /**
+     * @struct QueryContext
+     * @brief Every scratch buffer a query may need, pooled per thread and handed out by ContextLease.
+     *
+     * The graph itself is never written after it is built, so queries on one graph can run on many threads at once
+     * as long as each thread works in its own context.
+     */
+    struct QueryContext {
+        SearchBuffers route;        ///< For dijkstra() and aStar().
+        HopBuffers hop;             ///< For bidirectionalBfs().
+        LevelBuffers level;         ///< For multiSourceBfs().
+        SourceBatchBuffers batch;   ///< For allSourcesBfs().
+        StampedArray<int> dist{-1}; ///< For bfs() and the analyses built on it.
+        std::vector<int> parent;    ///< Previous airport of each airport reached by a traversal, or -1; stale elsewhere.
+        std::vector<int> queue;     ///< For bfs() and the analyses built on it.
+    };
+
+    /**
+     * @class ContextLease
+     * @brief A QueryContext taken out of the pool of the calling thread and handed back when the lease is destroyed.
+     *
+     * A context belongs to one lease at a time, so a search never shares its buffers with another one in progress,
+     * even on the same thread. A HopRouteIterator keeps the lease of its search, and stays valid however many queries
+     * run before it is done.
+     */
+    class ContextLease {
+    public:
+        /**
+         * @brief Takes an idle context of the calling thread, or creates one when they are all leased.
+         * @details Time complexity: O(1), besides allocating the context the first time.
+         */
+        ContextLease();
+
+        /**
+         * @brief Hands the context back to the pool of the calling thread.
+         * @details Time complexity: O(1) amortised
+         */
+        ~ContextLease();
+
+        ContextLease(ContextLease&& other) noexcept = default;
+        ContextLease& operator=(ContextLease&& other) noexcept;
+
+        QueryContext& operator*() const { return *context; }
+        QueryContext* operator->() const { return context.get(); }
+
+    private:
+        std::unique_ptr<QueryContext> context;
+    };
+
+    /**
+     * @class HopRouteIterator
+     * @brief Lazily lists every minimum-hop route found by the last multiSourceBfs() or bidirectionalBfs().
+     *
+     * Each route is made of a prefix, walked from a join airport back to a level-0 airport over the parents one level
+     * closer, and an optional suffix, walked from a second join airport forward to a level-0 airport of the other
+     * side. Routes are
+     * produced one at a time, so a caller can stop early or cap the count instead of building every route up front.
+     * The iterator owns the lease of the context its search ran in, so the buffers it reads stay untouched until the
+     * iterator is destroyed.
+     * @tparam RoutePredicate The route predicate of the search, see RouteQuery.h; it is stored by value, so its test
+     * is inlined into the walk.
+     */
+    template <class RoutePredicate>
+    class HopRouteIterator {
+    public:
+        /**
+         * @brief Gets the next route.
+         * @param route Output; the airport ids of the route, from its source to its target.
+         * @return False once every route, or as many as the cap allows, has been produced.
+         * @details Time complexity: O(L * D) amortised, where L is the length of a route and D the greatest degree.
+         */
+        bool next(std::vector<int>& route);
+
+        /**
+         * @brief Gets the airport stored under an id of a route.
+         * @param id The airport id.
+         * @return The airport.
+         * @details Time complexity: O(1)
+         */
+        const Airport& getAirport(int id) const { return graph->getAirport(id); }
+
+    private:
+        friend class CsrGraph;
+
+        struct Frame {
+            int vertex;
+            int edge;
+        };
+
+        HopRouteIterator(const CsrGraph& graph, const RoutePredicate& allowed, ContextLease context,
+                         const StampedArray<int>& prefixLevel, const StampedArray<int>* suffixLevel,
+                         std::vector<std::pair<int, int>> joins, size_t cap);
+
+        void start(std::vector<Frame>& stack, int vertex, bool backward) const;
+        bool walk(std::vector<Frame>& stack, bool backward, const StampedArray<int>& level, bool& fresh) const;
+
+        const CsrGraph* graph;
+        RoutePredicate allowed;
+        ContextLease context;
+        const StampedArray<int>* prefixLevel;
+        const StampedArray<int>* suffixLevel;
+        std::vector<std::pair<int, int>> joins;
+        size_t join;
+        size_t remaining;
+        bool needPrefix;
+        bool prefixFresh;
+        bool suffixFresh;
+        std::vector<Frame> prefix;
+        std::vector<Frame> suffix;
+    };
+
+    /**
+     * @brief Default constructor, builds an empty graph.
+     * @details Time complexity: O(1)
+     */
+    CsrGraph();
+
+    /**
+     * @brief Builds the CSR form of a loaded graph.
+     * @param g The graph to copy.
+     * @details Time complexity: O(V + E), where V is the number of airports and E the number of flights.
+     */
+    explicit CsrGraph(const Graph<Airport>& g);
+
+    /**
+     * @brief Restores a graph from arrays built earlier, e.g. by a snapshot.
+     * @param airports The airports, in the order of their ids.
+     * @param arrays The arrays, used as they are; Snapshot::Load() checks that they are consistent.
+     * @details Time complexity: O(V), where V is the number of airports.
+     */
+    CsrGraph(std::vector<Airport> airports, Arrays arrays);
+
+    /**
+     * @brief Gets the arrays of the graph, sharing their storage.
+     * @return The arrays.
+     * @details Time complexity: O(1)
+     */
+    Arrays getArrays() const;
+
+    /**
+     * @brief Gets the number of airports.
+     * @return The number of vertices.
+     * @details Time complexity: O(1)
+     */
+    int getNumVertex() const;
+
+    /**
+     * @brief Gets the number of routes, the airport pairs joined by at least one flight.
+     * @return The number of edges.
+     * @details Time complexity: O(1)
+     */
+    size_t getNumEdges() const;
+
+    /**
+     * @brief Gets the number of flights, counting each airline on a route.
+     * @return The number of flights.
+     * @details Time complexity: O(1)
+     */
+    size_t getNumFlights() const;
+
+    /**
+     * @brief Finds the id of the airport with the given code.
+     * @param code The airport code.
+     * @return The airport id, or -1 if there is no such airport.
+     * @details Time complexity: O(1) on average
+     */
+    int findVertex(const std::string& code) const;
+
+    /**
+     * @brief Gets the airport stored under an id.
+     * @param id The airport id.
+     * @return The airport.
+     * @details Time complexity: O(1)
+     */
+    const Airport& getAirport(int id) const;
+
+    /**
+     * @brief Gets the position of an airport on the unit sphere, as computed by Haversine::unitVector().
+     * @param v The airport id.
+     * @param coords Output, the x, y and z coordinates.
+     * @details Time complexity: O(1)
+     */
+    void unitVector(int v, double coords[3]) const {
+        coords[0] = unitX[v];
+        coords[1] = unitY[v];
+        coords[2] = unitZ[v];
+    }
+
+    /**
+     * @brief Gets the squared straight-line distance between two airports on the unit sphere.
+     * @param u The first airport id.
+     * @param v The second airport id.
+     * @return A value that orders airport pairs as their great-circle distances do.
+     * @details Time complexity: O(1)
+     */
+    double squaredChord(int u, int v) const {
+        double dx = unitX[u] - unitX[v];
+        double dy = unitY[u] - unitY[v];
+        double dz = unitZ[u] - unitZ[v];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /**
+     * @brief Gets the great-circle distance between two airports from their unit vectors.
+     * @param u The first airport id.
+     * @param v The second airport id.
+     * @return The distance, in kilometres.
+     * @details Uses atan2(|u x v|, u.v), which stays accurate for nearby and for antipodal airports alike.
+     * Time complexity: O(1)
+     */
+    double greatCircleDistance(int u, int v) const;
+
+    /**
+     * @brief Gets the airline code stored under an interned airline id.
+     * @param airlineId The airline id.
+     * @return The airline code.
+     * @details Time complexity: O(1)
+     */
+    const std::string& getAirlineCode(int airlineId) const;
+
+    /**
+     * @brief Index of the first outgoing route of an airport.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int edgesBegin(int v) const { return offsets[v]; }
+
+    /**
+     * @brief Index one past the last outgoing route of an airport.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int edgesEnd(int v) const { return offsets[v + 1]; }
+
+    /**
+     * @brief Number of flights out of an airport, counting each airline on a route.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int flightsOut(int v) const { return routeAirlineOffsets[offsets[v + 1]] - routeAirlineOffsets[offsets[v]]; }
+
+    /**
+     * @brief Index of the first incoming route of an airport.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int inEdgesBegin(int v) const { return inOffsets[v]; }
+
+    /**
+     * @brief Index one past the last incoming route of an airport.
+     * @param v The airport id.
+     * @details Time complexity: O(1)
+     */
+    int inEdgesEnd(int v) const { return inOffsets[v + 1]; }
+
+    /**
+     * @brief Origin airport id of an incoming route.
+     * @param e The incoming route index.
+     * @details Time complexity: O(1)
+     */
+    int inEdgeSource(int e) const { return inSources[e]; }
+
+    /**
+     * @brief Outgoing route index of an incoming route, to look up its airlines and weight.
+     * @param e The incoming route index.
+     * @details Time complexity: O(1)
+     */
+    int inEdgeRoute(int e) const { return inRoutes[e]; }
+
+    /**
+     * @brief Destination airport id of a route.
+     * @param e The route index.
+     * @details Time complexity: O(1)
+     */
+    int edgeDest(int e) const { return destinations[e]; }
+
+    /**
+     * @brief Index of the first airline flying a route.
+     * @param e The route index.
+     * @details Time complexity: O(1)
+     */
+    int edgeAirlinesBegin(int e) const { return routeAirlineOffsets[e]; }
+
+    /**
+     * @brief Index one past the last airline flying a route.
+     * @param e The route index.
+     * @details Time complexity: O(1)
+     */
+    int edgeAirlinesEnd(int e) const { return routeAirlineOffsets[e + 1]; }
+
+    /**
+     * @brief Airline of a flight, as its id in StringPool::airlineCodes().
+     * @param i An index between edgeAirlinesBegin() and edgeAirlinesEnd() of a route.
+     * @details Time complexity: O(1)
+     */
+    int flightAirline(int i) const { return routeAirlines[i]; }
+
+    /**
+     * @brief Tells whether a route may be taken under an airline filter, i.e. whether any of its airlines is allowed.
+     * @param e The route index.
+     * @param filter The airline filter.
+     * @details Time complexity: O(1) without a filter or for a route flown by a single airline, which is a single bit
+     * probe; O(A) otherwise, where A is the number of airlines flying the route.
+     */
+    bool edgeAllowed(int e, const AirlineFilter& filter) const {
+        if (filter.allowsAll()) {
+            return true;
+        }
+        int first = routeAirlineOffsets[e], last = routeAirlineOffsets[e + 1];
+        if (last - first == 1) {
+            return filter.allows(routeAirlines[first]);
+        }
+        for (int i = first; i < last; i++) {
+            if (filter.allows(routeAirlines[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Great-circle distance of a route, in kilometres.
+     * @param e The route index.
+     * @details Time complexity: O(1)
+     */
+    double edgeWeight(int e) const { return weights[e]; }
+
+    /**
+     * @brief Breadth-first search computing the number of flights from a source to every airport.
+     * @param source The source airport id.
+     * @param dist Output, reset to V slots; dist[v] is the hop distance to v, or -1 if v is unreachable.
+     * @param queue Output, the airports reached in the order they were reached, so the last one is the farthest.
+     * @return The greatest hop distance reached (the eccentricity of the source).
+     * @details Time complexity: O(R + E_R), where R is the number of airports reached and E_R their routes.
+     */
+    int bfs(int source, StampedArray<int>& dist, std::vector<int>& queue) const;
+
+    /**
+     * @brief Breadth-first search over the incoming routes, computing the number of flights from every airport to a target.
+     * @param target The target airport id.
+     * @param dist Output, reset to V slots; dist[v] is the hop distance from v, or -1 if v cannot reach the target.
+     * @param queue Output, the airports reached in the order they were reached, so the last one is the farthest.
+     * @return The greatest hop distance reached (the backward eccentricity of the target).
+     * @details Time complexity: O(R + E_R), where R is the number of airports reached and E_R their routes.
+     */
+    int reverseBfs(int target, StampedArray<int>& dist, std::vector<int>& queue) const;
+
+    /**
+     * @struct HopSummary
+     * @brief Hop distances from every airport, as computed by allSourcesBfs().
+     */
+    struct HopSummary {
+        std::vector<int> eccentricity;              ///< Greatest hop distance from each airport.
+        std::vector<int> farthest;                  ///< An airport at that distance from each airport, or itself.
+        std::vector<int> reachable;                 ///< Number of other airports each airport reaches.
+        std::vector<std::vector<int>> histogram;    ///< histogram[s][h]: airports exactly h flights away from s.
+        int diameter = 0;                           ///< Greatest eccentricity.
+        std::vector<std::pair<int, int>> farthestPairs;     ///< Every (source, target) at the diameter, by source.
+    };
+
+    /**
+     * @brief Runs a BFS from every airport, 64 sources at a time.
+     * @return The eccentricities, hop histograms and farthest pairs of every airport.
+     * @details Each airport keeps a 64-bit word per level state, bit i standing for the i-th source of the batch, so
+     * one pass over the routes advances all 64 searches by a level. Batches run on the shared thread pool.
+     * Time complexity: O(V / 64 * D * (V + E) + P), where D is the diameter and P the number of connected pairs.
+     */
+    HopSummary allSourcesBfs() const;
+
+    /**
+     * @brief Lists every pair of airports whose shortest route takes a given number of flights.
+     * @param hops The number of flights, usually the diameter.
+     * @return The (source, target) pairs, sorted by source and then target.
+     * @details Runs the searches of allSourcesBfs() on the thread pool but keeps nothing but the pairs, and stops
+     * each batch at that level. Time complexity: O(V / 64 * hops * (V + E) + P), where P is the number of pairs.
+     */
+    std::vector<std::pair<int, int>> pairsAtDistance(int hops) const;
+
+    /**
+     * @brief Dijkstra search for the route with the fewest kilometres from any source to any target.
+     * @param sources The ids of the origin airports, all starting at distance 0.
+     * @param targets The ids of the destination airports; the search stops when the first of them is settled.
+     * @param filter The airlines whose flights may be taken; a route is usable if any of its airlines is allowed.
+     * @param buffers Scratch state reused between calls; afterwards it holds the distances and parents of the search.
+     * @return The id of the target reached, or -1 if no target can be reached.
+     * @details Time complexity: O((V + E) log E). Stale heap entries are skipped when popped instead of being
+     * decreased in place.
+     */
+    int dijkstra(const std::vector<int>& sources, const std::vector<int>& targets,
+                 const AirlineFilter& filter, SearchBuffers& buffers) const;
+
+    /**
+     * @brief A* search for the route with the fewest kilometres from any source to any target.
+     * @details Same contract as dijkstra(), but airports are ordered by their distance plus the great-circle distance
+     * to the nearest target. That bound never overestimates, since every flight is itself a great-circle leg, so the
+     * route found is still the shortest while far fewer airports are settled on point-to-point queries. The nearest
+     * target is picked by squared chord and only its distance is computed in kilometres.
+     * Time complexity: O((V + E) log E + V * T), where T is the number of targets.
+     */
+    int aStar(const std::vector<int>& sources, const std::vector<int>& targets,
+              const AirlineFilter& filter, SearchBuffers& buffers) const;
+
+    /**
+     * @brief Rebuilds the route found by the last search.
+     * @param target The airport returned by the search.
+     * @param buffers The buffers filled by the search.
+     * @return The airport ids of the route, from the source to the target.
+     * @details Time complexity: O(L), where L is the number of flights on the route.
+     */
+    std::vector<int> route(int target, const SearchBuffers& buffers) const;
+
+    /**
+     * @brief Bidirectional breadth-first search for the fewest flights between two airports.
+     * @param source The origin airport id.
+     * @param target The destination airport id.
+     * @tparam RoutePredicate Tells which routes may be taken; see RouteQuery.h.
+     * @param allowed The route predicate.
+     * @param buffers Scratch state reused between calls; afterwards buffers.meetings holds every flight joining the
+     * two sides on a shortest route.
+     * @return The fewest flights from the source to the target, or -1 if there is no route.
+     * @details Grows the smaller of the two frontiers one whole level at a time, forwards over the outgoing flights and
+     * backwards over the incoming ones, and stops at the first level where they meet. The distance arrays are stamped
+     * rather than cleared, so the search only pays for the airports it reaches. Time complexity: O(V + E) in the
+     * worst case, but usually only the neighbourhoods of the two airports are visited.
+     */
+    template <class RoutePredicate>
+    int bidirectionalBfs(int source, int target, const RoutePredicate& allowed, HopBuffers& buffers) const;
+
+    /**
+     * @brief Lists the routes found by a bidirectionalBfs().
+     * @param allowed The same route predicate given to the search.
+     * @param context The lease of the context whose hop buffers the search filled; the iterator keeps it.
+     * @param cap The greatest number of routes to produce.
+     * @return An iterator over every route with the fewest flights.
+     * @details Time complexity: O(M), where M is the number of meeting flights; the routes are walked as the
+     * iterator advances.
+     */
+    template <class RoutePredicate>
+    HopRouteIterator<RoutePredicate> bidirectionalRoutes(const RoutePredicate& allowed, ContextLease context,
+                                                         size_t cap) const;
+
+    /**
+     * @brief Multi-source breadth-first search that stops at the first level reaching any target.
+     * @tparam Origins Selector of the origin airports; see RouteQuery.h for the policy contract.
+     * @tparam Destinations Selector of the destination airports.
+     * @tparam RoutePredicate Tells which routes may be taken.
+     * @param origins The origin airports, all on level 0.
+     * @param targets The destination airports.
+     * @param allowed The route predicate.
+     * @param buffers Scratch state reused between calls; afterwards buffers.reached holds the targets found.
+     * @return The fewest flights from any origin to any destination, or -1 if no destination can be reached.
+     * @details The selectors and the predicate are compile-time policies, so each combination gets its own copy of the
+     * loop with the membership and route tests inlined. Time complexity: O(V + E), however many origins there are.
+     */
+    template <class Origins, class Destinations, class RoutePredicate>
+    int multiSourceBfs(const Origins& origins, const Destinations& targets, const RoutePredicate& allowed,
+                       LevelBuffers& buffers) const;
+
+    /**
+     * @brief Lists the routes found by a multiSourceBfs().
+     * @param allowed The same route predicate given to the search.
+     * @param context The lease of the context whose level buffers the search filled; the iterator keeps it.
+     * @param cap The greatest number of routes to produce.
+     * @return An iterator over every route with the minimum number of flights from any source to any target.
+     * @details Time complexity: O(T), where T is the number of targets reached; the routes are walked as the
+     * iterator advances.
+     */
+    template <class RoutePredicate>
+    HopRouteIterator<RoutePredicate> minimumHopRoutes(const RoutePredicate& allowed, ContextLease context,
+                                                      size_t cap) const;
+
+    /**
+     * @struct Diameter
+     * @brief The diameter of the graph, one pair of airports that realises it, and the work it took to find.
+     */
+    struct Diameter {
+        int hops = 0;       ///< The greatest hop distance between two airports connected by some route.
+        int from = -1;      ///< Id of the airport the longest shortest route starts at, or -1 for an empty graph.
+        int to = -1;        ///< Id of the airport the longest shortest route ends at, or -1 for an empty graph.
+        int bfsRuns = 0;    ///< Number of breadth-first searches run.
+    };
+
+    /**
+     * @brief Calculates the exact diameter of the graph by bounding eccentricities (iFUB for directed graphs).
+     * @return The diameter and a witness pair of airports.
+     * @details A forward and a backward BFS from the best connected airport r bound every distance by
+     * d(x, y) <= d(x, r) + d(r, y). Airports that r does not reach, or that do not reach r, are searched first; then
+     * the airports at backward (forward) distance i from r get a forward (backward) BFS, for i from the largest level
+     * down. Level i is skipped, and the search stops, once the greatest distance found is at least 2 * i: every pair
+     * not searched yet is then at most d(x, r) + d(r, y) <= 2 * i apart.
+     * The searches of a level run on the shared thread pool.
+     * Time complexity: O(k * (V + E)), where k is the number of searches; O(V * (V + E)) in the worst case, but a
+     * small fraction of V on hub-and-spoke networks.
+     */
+    Diameter findDiameter() const;
+
+    /**
+     * @brief Calculates the diameter of the graph.
+     * @return The greatest hop distance between two airports connected by some route.
+     * @details Time complexity: see findDiameter().
+     */
+    int calculateDiameter() const;
+
+    /**
+     * @brief Finds the articulation points of the graph.
+     * @return The set of articulation airports.
+     * @details Time complexity: O(V + E)
+     */
+    std::unordered_set<Airport> findArticulationPoints() const;
+
+private:
+    std::vector<Airport> airports;
+    Column<double> unitX;
+    Column<double> unitY;
+    Column<double> unitZ;
+    std::unordered_map<int, int> codeToId;
+    Column<int> offsets;
+    Column<int> destinations;
+    Column<double> weights;
+    Column<int> routeAirlineOffsets;
+    Column<int> routeAirlines;
+    Column<int> inOffsets;
+    Column<int> inSources;
+    Column<int> inRoutes;
+
+    static constexpr int batchSize = 64;    ///< Sources per bit-parallel batch, one per bit of a word.
+
+    void indexAirports();
+
+    void startBatch(SourceBatchBuffers& buffers, int first, int count) const;
+    bool advanceBatch(SourceBatchBuffers& buffers) const;
+    void frontierPairs(const SourceBatchBuffers& buffers, int first, std::vector<std::pair<int, int>>& pairs) const;
+    int shortestRoute(const std::vector<int>& sources, const std::vector<int>& targets,
+                      const AirlineFilter& filter, bool useEstimate, SearchBuffers& buffers) const;
+
+    void dfsArticulationPoints(int v, std::vector<int>& num, std::vector<int>& low, std::vector<char>& processing,
+                               std::vector<int>& stack, int& index, std::unordered_set<Airport>& articPoints) const;
+};
+
+template <class Origins, class Destinations, class RoutePredicate>
+int CsrGraph::multiSourceBfs(const Origins& origins, const Destinations& targets, const RoutePredicate& allowed,
+                             LevelBuffers& buffers) const {
+    buffers.level.reset(airports.size());
+    buffers.frontier.clear();
+    buffers.reached.clear();
+
+    origins.forEach(*this, [&](int s) {
+        if (buffers.level[s] < 0) {
+            buffers.level.set(s, 0);
+            buffers.frontier.push_back(s);
+            if (targets.contains(*this, s)) {
+                buffers.reached.push_back(s);
+            }
+        }
+    });
+
+    int depth = 0;
+    while (buffers.reached.empty() && !buffers.frontier.empty()) {
+        depth++;
+        buffers.nextFrontier.clear();
+        for (int v : buffers.frontier) {
+            for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+                if (!allowed(*this, e)) {
+                    continue;
+                }
+                int w = destinations[e];
+                if (buffers.level[w] < 0) {
+                    buffers.level.set(w, depth);
+                    buffers.nextFrontier.push_back(w);
+                    if (targets.contains(*this, w)) {
+                        buffers.reached.push_back(w);
+                    }
+                }
+            }
+        }
+        buffers.frontier.swap(buffers.nextFrontier);
+    }
+
+    return buffers.reached.empty() ? -1 : depth;
+}
+
+template <class RoutePredicate>
+CsrGraph::HopRouteIterator<RoutePredicate> CsrGraph::minimumHopRoutes(const RoutePredicate& allowed,
+                                                                      ContextLease context, size_t cap) const {
+    const LevelBuffers& buffers = context->level;
+    std::vector<std::pair<int, int>> joins;
+    joins.reserve(buffers.reached.size());
+    for (int t : buffers.reached) {
+        joins.emplace_back(t, -1);
+    }
+    return HopRouteIterator<RoutePredicate>(*this, allowed, std::move(context), buffers.level, nullptr,
+                                            std::move(joins), cap);
+}
+
+template <class RoutePredicate>
+int CsrGraph::bidirectionalBfs(int source, int target, const RoutePredicate& allowed, HopBuffers& buffers) const {
+    buffers.forwardDist.reset(airports.size());
+    buffers.backwardDist.reset(airports.size());
+    buffers.forwardFrontier.assign(1, source);
+    buffers.backwardFrontier.assign(1, target);
+    buffers.meetings.clear();
+    buffers.forwardDist.set(source, 0);
+    buffers.backwardDist.set(target, 0);
+
+    if (source == target) {
+        buffers.meetings.emplace_back(source, -1);
+        return 0;
+    }
+
+    // Keeps the flights (v, w) giving the fewest flights so far; a whole level is scanned before stopping, so
+    // every shortest route crosses exactly one of them.
+    int best = std::numeric_limits<int>::max();
+    auto meet = [&](int v, int w) {
+        int length = buffers.forwardDist[v] + 1 + buffers.backwardDist[w];
+        if (length < best) {
+            best = length;
+            buffers.meetings.clear();
+        }
+        if (length == best) {
+            buffers.meetings.emplace_back(v, w);
+        }
+    };
+
+    while (buffers.meetings.empty() && !buffers.forwardFrontier.empty() && !buffers.backwardFrontier.empty()) {
+        buffers.nextFrontier.clear();
+        if (buffers.forwardFrontier.size() <= buffers.backwardFrontier.size()) {
+            for (int v : buffers.forwardFrontier) {
+                for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+                    if (!allowed(*this, e)) {
+                        continue;
+                    }
+                    int w = destinations[e];
+                    if (buffers.backwardDist[w] >= 0) {
+                        meet(v, w);
+                    }
+                    if (buffers.forwardDist[w] < 0) {
+                        buffers.forwardDist.set(w, buffers.forwardDist[v] + 1);
+                        buffers.nextFrontier.push_back(w);
+                    }
+                }
+            }
+            buffers.forwardFrontier.swap(buffers.nextFrontier);
+        } else {
+            for (int w : buffers.backwardFrontier) {
+                for (int e = inOffsets[w]; e < inOffsets[w + 1]; e++) {
+                    if (!allowed(*this, inRoutes[e])) {
+                        continue;
+                    }
+                    int v = inSources[e];
+                    if (buffers.forwardDist[v] >= 0) {
+                        meet(v, w);
+                    }
+                    if (buffers.backwardDist[v] < 0) {
+                        buffers.backwardDist.set(v, buffers.backwardDist[w] + 1);
+                        buffers.nextFrontier.push_back(v);
+                    }
+                }
+            }
+            buffers.backwardFrontier.swap(buffers.nextFrontier);
+        }
+    }
+
+    return buffers.meetings.empty() ? -1 : best;
+}
+
+template <class RoutePredicate>
+CsrGraph::HopRouteIterator<RoutePredicate> CsrGraph::bidirectionalRoutes(const RoutePredicate& allowed,
+                                                                         ContextLease context, size_t cap) const {
+    const HopBuffers& buffers = context->hop;
+    std::vector<std::pair<int, int>> meetings = buffers.meetings;
+    return HopRouteIterator<RoutePredicate>(*this, allowed, std::move(context), buffers.forwardDist,
+                                            &buffers.backwardDist, std::move(meetings), cap);
+}
+
+template <class RoutePredicate>
+CsrGraph::HopRouteIterator<RoutePredicate>::HopRouteIterator(const CsrGraph& graph, const RoutePredicate& allowed,
+                                                             ContextLease context,
+                                                             const StampedArray<int>& prefixLevel,
+                                                             const StampedArray<int>* suffixLevel,
+                                                             std::vector<std::pair<int, int>> joins, size_t cap)
+        : graph(&graph), allowed(allowed), context(std::move(context)), prefixLevel(&prefixLevel),
+          suffixLevel(suffixLevel),
+          joins(std::move(joins)), join(0), remaining(cap), needPrefix(true), prefixFresh(true), suffixFresh(true) {
+    if (!this->joins.empty()) {
+        start(prefix, this->joins[0].first, true);
+    }
+}
+
+template <class RoutePredicate>
+bool CsrGraph::HopRouteIterator<RoutePredicate>::next(std::vector<int>& route) {
+    while (remaining > 0 && join < joins.size()) {
+        int suffixStart = joins[join].second;
+        if (needPrefix) {
+            if (!walk(prefix, true, *prefixLevel, prefixFresh)) {
+                if (++join < joins.size()) {
+                    start(prefix, joins[join].first, true);
+                    prefixFresh = true;
+                }
+                continue;
+            }
+            needPrefix = false;
+            if (suffixStart != -1) {
+                start(suffix, suffixStart, false);
+                suffixFresh = true;
+            }
+        }
+
+        if (suffixStart != -1 && !walk(suffix, false, *suffixLevel, suffixFresh)) {
+            needPrefix = true;
+            continue;
+        }
+
+        route.clear();
+        for (auto it = prefix.rbegin(); it != prefix.rend(); it++) {
+            route.push_back(it->vertex);
+        }
+        if (suffixStart != -1) {
+            for (const Frame& f : suffix) {
+                route.push_back(f.vertex);
+            }
+        } else {
+            needPrefix = true;
+        }
+        remaining--;
+        return true;
+    }
+    return false;
+}
+
+// Starts a walk at an airport, backwards over incoming flights or forwards over outgoing ones
+template <class RoutePredicate>
+void CsrGraph::HopRouteIterator<RoutePredicate>::start(std::vector<Frame>& stack, int vertex, bool backward) const {
+    stack.clear();
+    stack.push_back({vertex, backward ? graph->inOffsets[vertex] : graph->offsets[vertex]});
+}
+
+// Advances a walk to its next path ending on level 0; the previous path, if any, is still on the stack
+template <class RoutePredicate>
+bool CsrGraph::HopRouteIterator<RoutePredicate>::walk(std::vector<Frame>& stack, bool backward,
+                                                      const StampedArray<int>& level, bool& fresh) const {
+    if (fresh) {
+        fresh = false;
+        if (level[stack.back().vertex] == 0) {
+            return true;
+        }
+    } else {
+        stack.pop_back();
+    }
+
+    const Column<int>& edgeOffsets = backward ? graph->inOffsets : graph->offsets;
+    const Column<int>& endpoints = backward ? graph->inSources : graph->destinations;
+
+    while (!stack.empty()) {
+        Frame& f = stack.back();
+        int end = edgeOffsets[f.vertex + 1];
+        int u = -1;
+        while (f.edge < end) {
+            int e = f.edge++;
+            int candidate = endpoints[e];
+            if (level[candidate] != level[f.vertex] - 1 ||
+                !allowed(*graph, backward ? graph->inRoutes[e] : e)) {
+                continue;
+            }
+            u = candidate;
+            break;
+        }
+
+        if (u == -1) {
+            stack.pop_back();
+            continue;
+        }
+        stack.push_back({u, edgeOffsets[u]});
+        if (level[u] == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif //PROJETO_2_CSRGRAPH_H
@@ -0,0 +1,150 @@
+#include "CsvReader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Opens and maps a CSV file.
+ * @param path The path of the file.
+ * @details Time complexity: O(1)
+ */
+CsvReader::CsvReader(const std::string& path) : path(path), file(std::make_shared<const MappedFile>(path)),
+                                                cursor(file->data()), end(file->data() + file->size()),
+                                                lineNumber(0) {}
+
+// Reader over a line-aligned range of the parent's mapping
+CsvReader::CsvReader(const CsvReader& parent, const char* begin, const char* end) :
+        path(parent.path), file(parent.file), cursor(begin), end(end), lineNumber(0) {}
+
+/**
+ * @brief Checks if the file was opened successfully.
+ * @return True if the file can be read.
+ * @details Time complexity: O(1)
+ */
+bool CsvReader::isOpen() const {
+    return file->isOpen();
+}
+
+/**
+ * @brief Advances to the next non-empty row and splits it into fields.
+ * @return False once the end of the file is reached.
+ * @details Time complexity: O(l), where l is the length of the row.
+ */
+bool CsvReader::nextRow() {
+    fields.clear();
+    while (cursor < end) {
+        auto newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = newline != nullptr ? newline : end;
+        const char* lineBegin = cursor;
+        cursor = newline != nullptr ? newline + 1 : end;
+        lineNumber++;
+
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        if (lineEnd == lineBegin) {
+            continue;
+        }
+
+        const char* fieldBegin = lineBegin;
+        for (const char* c = lineBegin; c < lineEnd; c++) {
+            if (*c == ',') {
+                fields.emplace_back(fieldBegin, c - fieldBegin);
+                fieldBegin = c + 1;
+            }
+        }
+        fields.emplace_back(fieldBegin, lineEnd - fieldBegin);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Splits the rows that have not been read yet into line-aligned parts of similar size.
+ * @param parts The number of parts wanted.
+ * @return At most parts readers over consecutive ranges of the file, in file order. They share the mapping and
+ *         number their lines from 1 at the start of their own range.
+ * @details Time complexity: O(parts + l), where l is the length of the longest line.
+ */
+std::vector<CsvReader> CsvReader::split(size_t parts) const {
+    std::vector<CsvReader> readers;
+    size_t remaining = end - cursor;
+    size_t partSize = remaining / std::max<size_t>(parts, 1) + 1;
+
+    const char* begin = cursor;
+    while (begin < end) {
+        const char* partEnd = end;
+        if ((size_t) (end - begin) > partSize) {
+            auto newline = static_cast<const char*>(std::memchr(begin + partSize, '\n', end - begin - partSize));
+            partEnd = newline != nullptr ? newline + 1 : end;
+        }
+        readers.push_back(CsvReader(*this, begin, partEnd));
+        begin = partEnd;
+    }
+    return readers;
+}
+
+/**
+ * @brief Gets the path of the file.
+ * @return The path.
+ * @details Time complexity: O(1)
+ */
+const std::string& CsvReader::getPath() const {
+    return path;
+}
+
+/**
+ * @brief Gets the line number of the current row, starting at 1.
+ * @return The line number.
+ * @details Time complexity: O(1)
+ */
+size_t CsvReader::getLineNumber() const {
+    return lineNumber;
+}
+
+/**
+ * @brief Gets the number of fields in the current row.
+ * @return The number of fields.
+ * @details Time complexity: O(1)
+ */
+size_t CsvReader::getFieldCount() const {
+    return fields.size();
+}
+
+/**
+ * @brief Gets a field of the current row.
+ * @param i The index of the field, smaller than getFieldCount().
+ * @return A view of the field's characters.
+ * @details Time complexity: O(1)
+ */
+std::string_view CsvReader::getField(size_t i) const {
+    return fields[i];
+}
+
+/**
+ * @brief Converts a field of the current row to a double with std::from_chars.
+ * @param i The index of the field, smaller than getFieldCount().
+ * @param value Receives the number.
+ * @return True if the whole field is a valid number.
+ * @details Time complexity: O(l), where l is the length of the field.
+ */
+bool CsvReader::getDouble(size_t i, double& value) const {
+    std::string_view field = fields[i];
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    if (first != last && *first == '+') {
+        first++;
+    }
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+/**
+ * @brief Reports a malformed current row on std::cerr, prefixed with the file name and line number.
+ * @param reason What is wrong with the row.
+ * @details Time complexity: O(1)
+ */
+void CsvReader::reportMalformed(const std::string& reason) const {
+    std::cerr << path << ":" << lineNumber << ": " << reason << std::endl;
+}
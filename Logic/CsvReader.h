@@ -0,0 +1,107 @@
+#ifndef PROJETO_2_CSVREADER_H
+#define PROJETO_2_CSVREADER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+/**
+ * @class CsvReader
+ * @brief Reads a comma-separated file row by row without copying it.
+ *
+ * The file is memory-mapped and every row is split in place into string_view fields that point into the mapping,
+ * so they stay valid for as long as the reader (or any reader split from it) exists. Trailing '\\r' characters and
+ * empty lines are skipped.
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Opens and maps a CSV file.
+     * @param path The path of the file.
+     * @details Time complexity: O(1)
+     */
+    explicit CsvReader(const std::string& path);
+
+    /**
+     * @brief Checks if the file was opened successfully.
+     * @return True if the file can be read.
+     * @details Time complexity: O(1)
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Advances to the next non-empty row and splits it into fields.
+     * @return False once the end of the file is reached.
+     * @details Time complexity: O(l), where l is the length of the row.
+     */
+    bool nextRow();
+
+    /**
+     * @brief Splits the rows that have not been read yet into line-aligned parts of similar size.
+     * @param parts The number of parts wanted.
+     * @return At most parts readers over consecutive ranges of the file, in file order. They share the mapping and
+     *         number their lines from 1 at the start of their own range.
+     * @details Time complexity: O(parts + l), where l is the length of the longest line.
+     */
+    std::vector<CsvReader> split(size_t parts) const;
+
+    /**
+     * @brief Gets the path of the file.
+     * @return The path.
+     * @details Time complexity: O(1)
+     */
+    const std::string& getPath() const;
+
+    /**
+     * @brief Gets the line number of the current row, starting at 1.
+     * @return The line number.
+     * @details Time complexity: O(1)
+     */
+    size_t getLineNumber() const;
+
+    /**
+     * @brief Gets the number of fields in the current row.
+     * @return The number of fields.
+     * @details Time complexity: O(1)
+     */
+    size_t getFieldCount() const;
+
+    /**
+     * @brief Gets a field of the current row.
+     * @param i The index of the field, smaller than getFieldCount().
+     * @return A view of the field's characters.
+     * @details Time complexity: O(1)
+     */
+    std::string_view getField(size_t i) const;
+
+    /**
+     * @brief Converts a field of the current row to a double with std::from_chars.
+     * @param i The index of the field, smaller than getFieldCount().
+     * @param value Receives the number.
+     * @return True if the whole field is a valid number.
+     * @details Time complexity: O(l), where l is the length of the field.
+     */
+    bool getDouble(size_t i, double& value) const;
+
+    /**
+     * @brief Reports a malformed current row on std::cerr, prefixed with the file name and line number.
+     * @param reason What is wrong with the row.
+     * @details Time complexity: O(1)
+     */
+    void reportMalformed(const std::string& reason) const;
+
+private:
+    std::string path;
+    std::shared_ptr<const MappedFile> file;
+    const char* cursor;
+    const char* end;
+    size_t lineNumber;
+    std::vector<std::string_view> fields;
+
+    CsvReader(const CsvReader& parent, const char* begin, const char* end);
+};
+
+#endif //PROJETO_2_CSVREADER_H
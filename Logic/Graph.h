@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 #include "Airline.h"
+#include "StringPool.h"
 
 using namespace std;
 
@@ -37,11 +38,11 @@ class Vertex {
     int num;               // auxiliary field
     Vertex<T>* parent;
 
-    void addEdge(Vertex<T> *dest, double w, string airline);
+    void addEdge(Vertex<T> *dest, double w, const string &airline);
     bool removeEdgeTo(Vertex<T> *d);
 public:
     Vertex(T in);
-    T getInfo() const;
+    const T &getInfo() const;
     void setInfo(T in);
     bool isVisited() const;
     void setVisited(bool v);
@@ -86,15 +87,16 @@ template <class T>
 class Edge {
     Vertex<T> * dest;      // destination vertex
     double weight;         // edge weight
-    string airline;        // airline code
+    int airline;           // interned airline code
 public:
-    Edge(Vertex<T> *d, double w,string airline);
+    Edge(Vertex<T> *d, double w,const string &airline);
     Vertex<T> *getDest() const;
     void setDest(Vertex<T> *dest);
     double getweight() const;
     void setweight(double weight);
-    std::string getAirline()const ;
-    void setAirline(string airline);
+    const std::string &getAirline()const ;
+    int getAirlineId() const;
+    void setAirline(const string &airline);
     friend class Graph<T>;
     friend class Vertex<T>;
 };
@@ -106,6 +108,7 @@ public:
 template <class T>
 class Graph {
     vector<Vertex<T> *> vertexSet;  // vertex set
+    unordered_map<T, Vertex<T> *> vertexIndex; // content -> vertex lookup
     stack<Vertex<T>> stack_;        // auxiliary field
     list<list<T>> list_sccs;        // auxiliary field
 
@@ -117,9 +120,9 @@ public:
     int calculateDiameter() const;
     bool addVertex(const T &in);
     bool removeVertex(const T &in);
-    bool addEdge(const T &sourc, const T &dest, double w,string airline);
+    bool addEdge(const T &sourc, const T &dest, double w,const string &airline);
     bool removeEdge(const T &sourc, const T &dest);
-    vector<Vertex<T> * > getVertexSet() const;
+    const vector<Vertex<T> * > &getVertexSet() const;
     vector<T> dfs() const;
     vector<T> dfs(const T & source) const;
     vector<T> bfs(const T &source) const;
@@ -156,7 +159,7 @@ int Graph<T>::calculateDiameter() const {
         T airport = a->getInfo();
         this->bfsDifferent(airport);
         for (Vertex<T>* b : getVertexSet()){
-            if (b->getNum() > max_diameter)
+            if (b->isVisited() && b->getNum() > max_diameter)
             {
                 max_diameter = b->getNum();
             }
@@ -177,7 +180,7 @@ int Graph<T>::calculateDiameter() const {
  *   - The constructor has constant time complexity as it performs basic assignment.
  */
 template <class T>
-Vertex<T>::Vertex(T in): info(in) {}
+Vertex<T>::Vertex(T in): info(in), visited(false), processing(false), low(0), indegree(0), num(0), parent(nullptr) {}
 
 /**
  * @brief Edge class constructor.
@@ -187,11 +190,12 @@ Vertex<T>::Vertex(T in): info(in) {}
  * @param airline The airline code associated with the edge.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(1)
- *   - The constructor has constant time complexity as it performs basic assignments.
+ * Time Complexity: O(l) on average, where l is the length of the airline code
+ *   - The airline code is interned in StringPool::airlineCodes().
  */
 template <class T>
-Edge<T>::Edge(Vertex<T> *d, double w,string airline): dest(d), weight(w),airline(airline) {}
+Edge<T>::Edge(Vertex<T> *d, double w,const string &airline): dest(d), weight(w),
+                                                             airline(StringPool::airlineCodes().intern(airline)) {}
 
 /**
  * @brief Gets the number of vertices in the graph.
@@ -214,7 +218,7 @@ int Graph<T>::getNumVertex() const {
  *   - The function has constant time complexity as it returns a reference to the vertex set.
  */
 template <class T>
-vector<Vertex<T> * > Graph<T>::getVertexSet() const {
+const vector<Vertex<T> * > &Graph<T>::getVertexSet() const {
     return vertexSet;
 }
 
@@ -227,7 +231,7 @@ vector<Vertex<T> * > Graph<T>::getVertexSet() const {
  *   - The function has constant time complexity as it retrieves the information of the vertex.
  */
 template<class T>
-T Vertex<T>::getInfo() const {
+const T &Vertex<T>::getInfo() const {
     return info;
 }
 
@@ -327,12 +331,12 @@ void Edge<T>::setweight(double weight) {
  * @param airline The new airline code.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(1)
- *   - The function has constant time complexity as it performs a basic assignment.
+ * Time Complexity: O(l) on average, where l is the length of the airline code
+ *   - The airline code is interned in StringPool::airlineCodes().
  */
 template<class T>
-void Edge<T>::setAirline(std::string airline) {
-    Edge::airline = airline;
+void Edge<T>::setAirline(const std::string &airline) {
+    Edge::airline = StringPool::airlineCodes().intern(airline);
 }
 
 /**
@@ -344,7 +348,19 @@ void Edge<T>::setAirline(std::string airline) {
  *   - The function has constant time complexity as it retrieves the airline code.
  */
 template<class T>
-std::string Edge<T>::getAirline() const{
+const std::string &Edge<T>::getAirline() const{
+    return StringPool::airlineCodes().get(airline);
+}
+
+/**
+ * @brief Gets the interned id of the airline code associated with the edge.
+ * @return The id of the airline code in StringPool::airlineCodes().
+ * @tparam T The type of information stored in the vertices.
+ *
+ * Time Complexity: O(1)
+ */
+template<class T>
+int Edge<T>::getAirlineId() const{
     return airline;
 }
 
@@ -357,16 +373,15 @@ std::string Edge<T>::getAirline() const{
  * @return A pointer to the vertex if found, or nullptr if not found.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(V)
- *   - The function has linear time complexity as it iterates through the vertex set to find the desired vertex.
- *     (V is the number of vertices in the graph.)
+ * Time Complexity: O(1) on average
+ *   - The function looks the content up in the hash index kept by addVertex and removeVertex.
  */
 template <class T>
 Vertex<T> * Graph<T>::findVertex(const T &in) const {
-    for (auto v : vertexSet)
-        if (v->info == in)
-            return v;
-    return NULL;
+    auto it = vertexIndex.find(in);
+    if (it == vertexIndex.end())
+        return NULL;
+    return it->second;
 }
 
 /**
@@ -510,15 +525,16 @@ void Vertex<T>::setAdj(const vector<Edge<T>> &adj) {
  * @return True if the addition is successful, false if a vertex with the same content already exists.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(V)
- *   - The function calls the findVertex method, which has a linear time complexity.
- *     (V is the number of vertices in the graph.)
+ * Time Complexity: O(1) on average
+ *   - The function calls the findVertex method, which is a hash lookup, and registers the new vertex in the index.
  */
 template <class T>
 bool Graph<T>::addVertex(const T &in) {
     if (findVertex(in) != NULL)
         return false;
-    vertexSet.push_back(new Vertex<T>(in));
+    auto v = new Vertex<T>(in);
+    vertexSet.push_back(v);
+    vertexIndex.emplace(in, v);
     return true;
 }
 
@@ -537,13 +553,12 @@ bool Graph<T>::addVertex(const T &in) {
  * @return True if the addition is successful, false if the source or destination vertex does not exist.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(V)
- *   - The function calls the findVertex method twice, each with linear time complexity.
+ * Time Complexity: O(1) on average
+ *   - The function calls the findVertex method twice, each a hash lookup.
  *     Additionally, the Vertex<T>::addEdge method is called, which has a constant time complexity.
- *     (V is the number of vertices in the graph.)
  */
 template <class T>
-bool Graph<T>::addEdge(const T &sourc, const T &dest, double w,string airline) {
+bool Graph<T>::addEdge(const T &sourc, const T &dest, double w,const string &airline) {
     auto v1 = findVertex(sourc);
     auto v2 = findVertex(dest);
     if (v1 == NULL || v2 == NULL)
@@ -567,7 +582,7 @@ bool Graph<T>::addEdge(const T &sourc, const T &dest, double w,string airline) {
  *   - The function has constant time complexity as it appends an edge to the vector of outgoing edges.
  */
 template <class T>
-void Vertex<T>::addEdge(Vertex<T> *d, double w,string airline) {
+void Vertex<T>::addEdge(Vertex<T> *d, double w,const string &airline) {
     adj.push_back(Edge<T>(d, w,airline));
 }
 
@@ -584,10 +599,10 @@ void Vertex<T>::addEdge(Vertex<T> *d, double w,string airline) {
  * @return True if the removal is successful, false if such an edge does not exist.
  * @tparam T The type of information stored in the vertices.
  *
- * Time Complexity: O(V)
- *   - The function calls the findVertex method twice, each with linear time complexity.
+ * Time Complexity: O(E)
+ *   - The function calls the findVertex method twice, each a hash lookup.
  *     Additionally, the Vertex<T>::removeEdgeTo method is called, which has linear time complexity.
- *     (V is the number of vertices in the graph.)
+ *     (E is the number of outgoing edges of the source vertex.)
  */
 template <class T>
 bool Graph<T>::removeEdge(const T &sourc, const T &dest) {
@@ -644,6 +659,7 @@ bool Graph<T>::removeVertex(const T &in) {
         if ((*it)->info  == in) {
             auto v = *it;
             vertexSet.erase(it);
+            vertexIndex.erase(in);
             for (auto u : vertexSet)
                 u->removeEdgeTo(v);
             delete v;
@@ -745,6 +761,7 @@ vector<T> Graph<T>::bfs(const T & source) const {
             }
         }
     }
+    return res;
 }
 /**
  * @brief Performs a breadth-first search (bfs) in the graph, starting from the vertex with the given source contents.
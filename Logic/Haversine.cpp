@@ -0,0 +1,312 @@
+#include "Haversine.h"
+#include <cmath>
+
+/**
+ * @brief Calculates the Haversine distance between two coordinates.
+ * @param lat1 The latitude of the first point.
+ * @param lon1 The longitude of the first point.
+ * @param lat2 The latitude of the second point.
+ * @param lon2 The longitude of the second point.
+ * @return The distance between the two points, in kilometres.
+ * @details Time complexity: O(1)
+ */
+double Haversine::distance(double lat1, double lon1, double lat2, double lon2) {
+    double dLat = (lat2 - lat1) *
+                  M_PI / 180.0;
+    double dLon = (lon2 - lon1) *
+                  M_PI / 180.0;
+
+    // convert to radians
+    lat1 = (lat1) * M_PI / 180.0;
+    lat2 = (lat2) * M_PI / 180.0;
+
+    double a = pow(sin(dLat / 2), 2) +
+               pow(sin(dLon / 2), 2) *
+               cos(lat1) * cos(lat2);
+
+    double c = 2 * asin(sqrt(a));
+    return EarthRadius * c;
+}
+
+/*
+ * The batch kernel. sin(x) on [0, pi/2] is its Taylor series up to x^19, and asin(x) on [0, 1/2] up to x^43; both
+ * truncation errors are below 1e-15. Larger arguments are folded into those ranges with
+ *     sin(x) = sin(pi - x),  cos(x) = sin(pi/2 - |x|),  asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)),
+ * and past a quarter of the globe the half angle is taken from the antipode, pi/2 - asin(sqrt(1 - a)), with 1 - a
+ * computed as a sum of squares rather than by subtraction. The branches are selects, so the same code runs on a
+ * double or on a vector of four.
+ */
+
+namespace {
+
+struct Series {
+    double sine[10];
+    double arcsine[22];
+};
+
+constexpr Series makeSeries() {
+    Series series{};
+    series.sine[0] = 1;
+    for (int n = 1; n < 10; n++) {
+        series.sine[n] = -series.sine[n - 1] / ((2.0 * n) * (2.0 * n + 1));
+    }
+    series.arcsine[0] = 1;
+    for (int n = 1; n < 22; n++) {
+        series.arcsine[n] = series.arcsine[n - 1] * (2.0 * n - 1) * (2.0 * n - 1) / ((2.0 * n) * (2.0 * n + 1));
+    }
+    return series;
+}
+
+constexpr Series series = makeSeries();
+
+constexpr double Pi = M_PI;
+constexpr double Radians = M_PI / 180.0;
+
+#if defined(__GNUC__)
+// The kernel is inlined into each entry point, so that the AVX2 one is compiled with AVX2 throughout, and the series
+// are unrolled, which halves the time of a batch
+#define KERNEL inline __attribute__((always_inline))
+#define UNROLLED _Pragma("GCC unroll 24")
+#else
+#define KERNEL inline
+#define UNROLLED
+#endif
+
+#if defined(__GNUC__)
+constexpr size_t Width = 4;
+typedef double Vector __attribute__((vector_size(Width * sizeof(double))));
+typedef long long MaskVector __attribute__((vector_size(Width * sizeof(long long))));
+
+// The vectors are wrapped in structs, which are passed in memory whatever the target, so that no kernel function has
+// an ABI that depends on whether AVX is enabled
+struct Lanes {
+    Vector v;
+};
+
+struct Mask {
+    MaskVector m;
+};
+
+#define LANES_OPERATOR(op)                                                                                  \
+    KERNEL Lanes operator op(const Lanes& a, const Lanes& b) { return Lanes{a.v op b.v}; }                   \
+    KERNEL Lanes operator op(const Lanes& a, double b) { return Lanes{a.v op b}; }                           \
+    KERNEL Lanes operator op(double a, const Lanes& b) { return Lanes{a op b.v}; }
+LANES_OPERATOR(+)
+LANES_OPERATOR(-)
+LANES_OPERATOR(*)
+#undef LANES_OPERATOR
+
+#define MASK_OPERATOR(op)                                                                                   \
+    KERNEL Mask operator op(const Lanes& a, const Lanes& b) { return Mask{a.v op b.v}; }                     \
+    KERNEL Mask operator op(const Lanes& a, double b) { return Mask{a.v op b}; }
+MASK_OPERATOR(<)
+MASK_OPERATOR(>)
+MASK_OPERATOR(<=)
+#undef MASK_OPERATOR
+
+KERNEL Lanes operator-(const Lanes& a) { return Lanes{-a.v}; }
+
+KERNEL Lanes splat(double x) { return Lanes{Vector{x, x, x, x}}; }
+
+KERNEL double& lane(Lanes& x, size_t k) { return x.v[k]; }
+
+KERNEL Lanes squareRoot(const Lanes& x) {
+    return Lanes{Vector{std::sqrt(x.v[0]), std::sqrt(x.v[1]), std::sqrt(x.v[2]), std::sqrt(x.v[3])}};
+}
+
+KERNEL Lanes select(const Mask& condition, const Lanes& a, const Lanes& b) {
+    return Lanes{condition.m ? a.v : b.v};
+}
+#else
+constexpr size_t Width = 1;
+typedef double Lanes;
+
+KERNEL Lanes splat(double x) { return x; }
+
+KERNEL double& lane(Lanes& x, size_t) { return x; }
+
+KERNEL Lanes squareRoot(const Lanes& x) { return std::sqrt(x); }
+
+KERNEL Lanes select(bool condition, const Lanes& a, const Lanes& b) { return condition ? a : b; }
+#endif
+
+// sin(x) for x in [0, pi/2]
+KERNEL Lanes sine(const Lanes& x) {
+    Lanes y = x * x;
+    Lanes p = splat(series.sine[9]);
+    UNROLLED
+    for (int i = 8; i >= 0; i--) {
+        p = p * y + series.sine[i];
+    }
+    return x * p;
+}
+
+// asin(x) for x in [0, 1/2]
+KERNEL Lanes arcsine(const Lanes& x) {
+    Lanes y = x * x;
+    Lanes p = splat(series.arcsine[21]);
+    UNROLLED
+    for (int i = 20; i >= 0; i--) {
+        p = p * y + series.arcsine[i];
+    }
+    return x * p;
+}
+
+KERNEL Lanes absolute(const Lanes& x) { return select(x < 0, -x, x); }
+
+KERNEL Lanes haversine(const Lanes& lat1, const Lanes& lon1, const Lanes& lat2, const Lanes& lon2) {
+    Lanes halfLat = absolute((lat2 - lat1) * (Radians / 2));
+    Lanes halfSum = absolute((lat2 + lat1) * (Radians / 2));
+    Lanes halfLon = absolute((lon2 - lon1) * (Radians / 2));
+    Lanes cosLon = sine(absolute(Pi / 2 - halfLon));
+    halfLon = select(halfLon > Pi / 2, Pi - halfLon, halfLon);
+
+    Lanes sinLat = sine(halfLat);
+    Lanes sinSum = sine(halfSum);
+    Lanes sinLon = sine(halfLon);
+    Lanes cos1 = sine(Pi / 2 - absolute(lat1 * Radians));
+    Lanes cos2 = sine(Pi / 2 - absolute(lat2 * Radians));
+
+    // a = hav(angle) and its complement 1 - a = hav(pi - angle), each a sum of squares
+    Lanes a = sinLat * sinLat + sinLon * sinLon * cos1 * cos2;
+    Lanes complement = sinSum * sinSum + cosLon * cosLon * cos1 * cos2;
+    auto near = a <= complement;
+    Lanes x = squareRoot(select(near, a, complement));
+
+    Lanes folded = squareRoot((1 - x) * 0.5);
+    Lanes half = arcsine(select(x > 0.5, folded, x));
+    half = select(x > 0.5, Pi / 2 - 2 * half, half);
+    half = select(near, half, Pi / 2 - half);
+    return (2 * Haversine::EarthRadius) * half;
+}
+
+/**
+ * @brief Runs the kernel on whole blocks of Width pairs; the first point is shared when step1 is 0.
+ */
+KERNEL void blocks(const double* lat1, const double* lon1, size_t step1, const double* lat2, const double* lon2,
+                   double* out, size_t n) {
+    for (size_t i = 0; i + Width <= n; i += Width) {
+        Lanes a1, o1, a2, o2;
+        UNROLLED
+        for (size_t k = 0; k < Width; k++) {
+            lane(a1, k) = lat1[(i + k) * step1];
+            lane(o1, k) = lon1[(i + k) * step1];
+            lane(a2, k) = lat2[i + k];
+            lane(o2, k) = lon2[i + k];
+        }
+        Lanes d = haversine(a1, o1, a2, o2);
+        UNROLLED
+        for (size_t k = 0; k < Width; k++) {
+            out[i + k] = lane(d, k);
+        }
+    }
+}
+
+void blocksDefault(const double* lat1, const double* lon1, size_t step1, const double* lat2, const double* lon2,
+                   double* out, size_t n) {
+    blocks(lat1, lon1, step1, lat2, lon2, out, n);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("avx2,fma")))
+void blocksAvx2(const double* lat1, const double* lon1, size_t step1, const double* lat2, const double* lon2,
+                double* out, size_t n) {
+    blocks(lat1, lon1, step1, lat2, lon2, out, n);
+}
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+#endif
+
+/**
+ * @brief Runs the kernel on every pair; the last partial block is padded so that it goes through the same code.
+ */
+void batch(const double* lat1, const double* lon1, size_t step1, const double* lat2, const double* lon2,
+           double* out, size_t n) {
+    auto run = blocksDefault;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (hasAvx2()) {
+        run = blocksAvx2;
+    }
+#endif
+    size_t whole = n - n % Width;
+    run(lat1, lon1, step1, lat2, lon2, out, whole);
+    if (whole == n) {
+        return;
+    }
+
+    double a1[Width] = {}, o1[Width] = {}, a2[Width] = {}, o2[Width] = {}, d[Width];
+    for (size_t k = 0; whole + k < n; k++) {
+        a1[k] = lat1[(whole + k) * step1];
+        o1[k] = lon1[(whole + k) * step1];
+        a2[k] = lat2[whole + k];
+        o2[k] = lon2[whole + k];
+    }
+    run(a1, o1, 1, a2, o2, d, Width);
+    for (size_t k = 0; whole + k < n; k++) {
+        out[whole + k] = d[k];
+    }
+}
+
+}
+
+/**
+ * @brief Calculates the distances of many pairs of coordinates.
+ * @param lat1 The latitudes of the first points.
+ * @param lon1 The longitudes of the first points.
+ * @param lat2 The latitudes of the second points.
+ * @param lon2 The longitudes of the second points.
+ * @param out Output, out[i] is the distance between point i of each side, in kilometres.
+ * @param n The number of pairs.
+ * @details Time complexity: O(n)
+ */
+void Haversine::distances(const double* lat1, const double* lon1, const double* lat2, const double* lon2,
+                          double* out, size_t n) {
+    batch(lat1, lon1, 1, lat2, lon2, out, n);
+}
+
+/**
+ * @brief Calculates the distances from one point to many.
+ * @param lat The latitude of the point.
+ * @param lon The longitude of the point.
+ * @param lats The latitudes of the other points.
+ * @param lons The longitudes of the other points.
+ * @param out Output, out[i] is the distance to point i, in kilometres.
+ * @param n The number of other points.
+ * @details Time complexity: O(n)
+ */
+void Haversine::distancesFrom(double lat, double lon, const double* lats, const double* lons, double* out, size_t n) {
+    batch(&lat, &lon, 0, lats, lons, out, n);
+}
+
+/**
+ * @brief Converts a coordinate to a point on the unit sphere.
+ * @param latitude The latitude, in degrees.
+ * @param longitude The longitude, in degrees.
+ * @param coords Output, the x, y and z coordinates.
+ * @details Time complexity: O(1)
+ */
+void Haversine::unitVector(double latitude, double longitude, double coords[3]) {
+    double lat = latitude * M_PI / 180.0;
+    double lon = longitude * M_PI / 180.0;
+    coords[0] = cos(lat) * cos(lon);
+    coords[1] = cos(lat) * sin(lon);
+    coords[2] = sin(lat);
+}
+
+/**
+ * @brief Converts a great-circle distance to the squared chord between the unit vectors of its ends.
+ * @param kilometres The distance; anything past half the circumference gives the whole diameter.
+ * @return The squared straight-line distance, between 0 and 4.
+ * @details Time complexity: O(1)
+ */
+double Haversine::toSquaredChord(double kilometres) {
+    double angle = kilometres / EarthRadius;
+    if (angle >= M_PI) {
+        return 4;
+    }
+    double chord = 2 * sin(angle / 2);
+    return chord * chord;
+}
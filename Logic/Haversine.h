@@ -0,0 +1,83 @@
+#ifndef PROJETO_2_HAVERSINE_H
+#define PROJETO_2_HAVERSINE_H
+
+#include <cstddef>
+
+/**
+ * @class Haversine
+ * @brief Great-circle distances between coordinates given in degrees, one pair at a time or in batches.
+ *
+ * distance() is the reference formula used since the first version of the project. The batch functions take
+ * structure-of-arrays coordinates and evaluate the same formula with polynomial sine and arcsine, four pairs per
+ * step: with AVX2 and FMA when the processor has them, with SSE2 (or the target's own vector unit) otherwise, and
+ * one pair at a time on compilers without vector extensions. Latitudes must lie in [-90, 90] and longitudes in
+ * [-180, 180]. Searches that only compare distances work on unit vectors instead, see unitVector().
+ */
+class Haversine {
+public:
+    /// Radius of the Earth used by every distance, in kilometres.
+    static constexpr double EarthRadius = 6371;
+
+    /// Greatest error of a batch distance against the exact great-circle distance on this sphere, in kilometres
+    /// (measured below 1e-10 km). distance() stays within the same bound except within a few kilometres of the
+    /// antipode, where its arcsine is ill-conditioned and it can be off by up to half a metre.
+    static constexpr double MaxError = 1e-9;
+
+    /**
+     * @brief Calculates the Haversine distance between two coordinates.
+     * @param lat1 The latitude of the first point.
+     * @param lon1 The longitude of the first point.
+     * @param lat2 The latitude of the second point.
+     * @param lon2 The longitude of the second point.
+     * @return The distance between the two points, in kilometres.
+     * @details Time complexity: O(1)
+     */
+    static double distance(double lat1, double lon1, double lat2, double lon2);
+
+    /**
+     * @brief Calculates the distances of many pairs of coordinates.
+     * @param lat1 The latitudes of the first points.
+     * @param lon1 The longitudes of the first points.
+     * @param lat2 The latitudes of the second points.
+     * @param lon2 The longitudes of the second points.
+     * @param out Output, out[i] is the distance between point i of each side, in kilometres.
+     * @param n The number of pairs.
+     * @details Equal coordinates always give equal distances, wherever they are in the arrays.
+     * Time complexity: O(n)
+     */
+    static void distances(const double* lat1, const double* lon1, const double* lat2, const double* lon2,
+                          double* out, size_t n);
+
+    /**
+     * @brief Calculates the distances from one point to many.
+     * @param lat The latitude of the point.
+     * @param lon The longitude of the point.
+     * @param lats The latitudes of the other points.
+     * @param lons The longitudes of the other points.
+     * @param out Output, out[i] is the distance to point i, in kilometres.
+     * @param n The number of other points.
+     * @details Time complexity: O(n)
+     */
+    static void distancesFrom(double lat, double lon, const double* lats, const double* lons, double* out, size_t n);
+
+    /**
+     * @brief Converts a coordinate to a point on the unit sphere.
+     * @param latitude The latitude, in degrees.
+     * @param longitude The longitude, in degrees.
+     * @param coords Output, the x, y and z coordinates.
+     * @details The squared chord |p - q|^2 = 2 - 2 p.q between two such points grows with the great-circle distance,
+     * so it ranks airports by distance without any trigonometry; the angle between them is atan2(|p x q|, p.q).
+     * Time complexity: O(1)
+     */
+    static void unitVector(double latitude, double longitude, double coords[3]);
+
+    /**
+     * @brief Converts a great-circle distance to the squared chord between the unit vectors of its ends.
+     * @param kilometres The distance; anything past half the circumference gives the whole diameter.
+     * @return The squared straight-line distance, between 0 and 4.
+     * @details Time complexity: O(1)
+     */
+    static double toSquaredChord(double kilometres);
+};
+
+#endif //PROJETO_2_HAVERSINE_H
@@ -1,13 +1,19 @@
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <cmath>
 #include "LoadingFunctions.h"
+#include "CsvReader.h"
+#include "Haversine.h"
 #include "Logic.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
 
 std::unordered_set<Airport> LoadingFunctions::airports;
 std::unordered_set<Airline> LoadingFunctions::airlines;
 
+static const std::string SnapshotPath = "dataset/network.snapshot";
+static const std::vector<std::string> SourcePaths = {"dataset/airports.csv", "dataset/airlines.csv",
+                                                     "dataset/flights.csv"};
+
 
 
 /**
@@ -25,27 +31,31 @@ void LoadingFunctions::NormalizeString(std::string& str) {
 /**
  * @brief Loads airports into the graph from a CSV file.
  * @param g The graph to load airports into.
- * @details Time complexity: O(n*p), where n is the number of airports in the CSV file and p is the tokens vector size
+ * @details Time complexity: O(n), where n is the number of airports in the CSV file
  */
 void LoadingFunctions::LoadAirports(Graph<Airport>& g) {
-    std::ifstream file("dataset/airports.csv");
-    if (!file.is_open()) {
+    CsvReader file("dataset/airports.csv");
+    if (!file.isOpen()) {
         std::cerr << "Failed to open the CSV file." << std::endl;
+        return;
     }
 
-    std::string line;
-    getline(file, line);
+    file.nextRow();
 
-    while (getline(file, line)) {
-        std::istringstream lineStream(line);
-        std::vector<std::string> tokens;
-        std::string token;
+    while (file.nextRow()) {
+        if (file.getFieldCount() != 6) {
+            file.reportMalformed("expected 6 fields, found " + std::to_string(file.getFieldCount()));
+            continue;
+        }
 
-        while (getline(lineStream, token, ',')) {
-            tokens.push_back(token);
+        double latitude, longitude;
+        if (!file.getDouble(4, latitude) || !file.getDouble(5, longitude)) {
+            file.reportMalformed("invalid coordinates");
+            continue;
         }
 
-        Airport airport = Airport(tokens[0] , tokens[1] , tokens[2] , tokens[3] , stod(tokens[4]) ,stod(tokens[5]));
+        Airport airport = Airport(std::string(file.getField(0)), std::string(file.getField(1)),
+                                  std::string(file.getField(2)), std::string(file.getField(3)), latitude, longitude);
 
         if(!g.addVertex(airport)){
             std::cerr << "Failed to add vertex to graph" << std::endl;
@@ -53,47 +63,44 @@ void LoadingFunctions::LoadAirports(Graph<Airport>& g) {
 
         airports.insert(airport);
     }
-    file.close();
 }
 
 /**
  * @brief Loads airlines into the set of loaded airlines.
  * @param g The graph (not used here).
- * @details Time complexity: O(m*p), where m is the number of airlines in the CSV file and p is the tokens vector size
+ * @details Time complexity: O(m), where m is the number of airlines in the CSV file
  */
 void LoadingFunctions::LoadAirlines(Graph<Airport> &g) {
-    std::ifstream file("dataset/airlines.csv");
-
-    if (!file.is_open()) {
+    CsvReader file("dataset/airlines.csv");
+    if (!file.isOpen()) {
         std::cerr << "Failed to open the CSV file." << std::endl;
+        return;
     }
 
-    std::string line;
-    getline(file, line);
-
-    while (getline(file, line)) {
-        std::istringstream lineStream(line);
-        std::vector<std::string> tokens;
-        std::string token;
+    file.nextRow();
 
-        while (getline(lineStream, token, ',')) {
-            tokens.push_back(token);
+    while (file.nextRow()) {
+        if (file.getFieldCount() != 4) {
+            file.reportMalformed("expected 4 fields, found " + std::to_string(file.getFieldCount()));
+            continue;
         }
 
-        std::string temp = tokens[3];
-        NormalizeString(temp);
-
-        Airline airline = Airline(tokens[0] , tokens[1] , tokens[2] , temp);
+        Airline airline = Airline(std::string(file.getField(0)), std::string(file.getField(1)),
+                                  std::string(file.getField(2)), std::string(file.getField(3)));
 
         airlines.insert(airline);
     }
-    file.close();
 }
 
 /**
  * @brief Loads flights into the graph from a CSV file.
+ *
+ * The file is split into line-aligned chunks that are parsed on the shared thread pool. Each chunk resolves its
+ * airport codes against a prebuilt index and computes the Haversine weights into its own buffer; the buffers are then
+ * added to the graph in file order, so the result does not depend on the number of threads.
  * @param g The graph to load flights into.
- * @details Time complexity: O(p * n), where p is the number of flights in the CSV file and n is the number of airports.
+ * @details Time complexity: O(p / t + p), where p is the number of flights in the CSV file and t the number of threads;
+ *          the final merge into the graph is sequential.
  */
 void LoadingFunctions::LoadFlights(Graph<Airport> &g) {
     if(airports.empty())
@@ -104,45 +111,125 @@ void LoadingFunctions::LoadFlights(Graph<Airport> &g) {
     {
         LoadAirlines(g);
     }
-    std::ifstream file("dataset/flights.csv");
-
-    if (!file.is_open()) {
+    CsvReader file("dataset/flights.csv");
+    if (!file.isOpen()) {
         std::cerr << "Failed to open the CSV file." << std::endl;
+        return;
     }
 
-    std::string line;
-    getline(file, line);
-
-    while (getline(file, line)) {
-
-        std::istringstream lineStream(line);
-        std::vector<std::string> tokens;
-        std::string token;
+    // airport codes are short enough to stay in the small string buffer, so lookups do not allocate
+    std::unordered_map<std::string, const Airport*> airportsByCode;
+    airportsByCode.reserve(airports.size());
+    for (const Airport& airport : airports) {
+        airportsByCode.emplace(airport.getCode(), &airport);
+    }
 
-        while (getline(lineStream, token, ',')) {
-            tokens.push_back(token);
+    struct ParsedFlight {
+        const Airport* source;
+        const Airport* dest;
+        double weight;
+        std::string_view airline;
+    };
+    struct Chunk {
+        std::vector<ParsedFlight> flights;
+        std::vector<std::pair<size_t, std::string>> errors;
+        size_t lines = 0;
+    };
+
+    file.nextRow();
+
+    ThreadPool& pool = ThreadPool::getShared();
+    std::vector<CsvReader> readers = file.split(pool.size() * 4);
+    std::vector<Chunk> chunks(readers.size());
+
+    pool.parallelFor(readers.size(), [&](size_t i) {
+        CsvReader& reader = readers[i];
+        Chunk& chunk = chunks[i];
+        while (reader.nextRow()) {
+            if (reader.getFieldCount() != 3) {
+                chunk.errors.emplace_back(reader.getLineNumber(),
+                                          "expected 3 fields, found " + std::to_string(reader.getFieldCount()));
+                continue;
+            }
+
+            auto source = airportsByCode.find(std::string(reader.getField(0)));
+            auto dest = airportsByCode.find(std::string(reader.getField(1)));
+            if (source == airportsByCode.end() || dest == airportsByCode.end()) {
+                chunk.errors.emplace_back(reader.getLineNumber(), "unknown airport code");
+                continue;
+            }
+
+            chunk.flights.push_back({source->second, dest->second, 0, reader.getField(2)});
         }
-
-        Airport sourceAirport = Airport(tokens[0] , " ", " ", " ", 0.0 , 0.0);
-        Airport destAirport = Airport(tokens[1], " ", " "," ",0.0,0.0);
-
-        auto it = airports.find(sourceAirport);
-        if (it != airports.end()) {
-            sourceAirport = *it;
+        chunk.lines = reader.getLineNumber();
+
+        // the weights of the whole chunk in one batch
+        size_t n = chunk.flights.size();
+        std::vector<double> coordinates(5 * n);
+        double* lat1 = coordinates.data();
+        double* lon1 = lat1 + n;
+        double* lat2 = lon1 + n;
+        double* lon2 = lat2 + n;
+        double* weights = lon2 + n;
+        for (size_t j = 0; j < n; j++) {
+            lat1[j] = chunk.flights[j].source->getLatitude();
+            lon1[j] = chunk.flights[j].source->getLongitude();
+            lat2[j] = chunk.flights[j].dest->getLatitude();
+            lon2[j] = chunk.flights[j].dest->getLongitude();
         }
+        Haversine::distances(lat1, lon1, lat2, lon2, weights, n);
+        for (size_t j = 0; j < n; j++) {
+            chunk.flights[j].weight = weights[j];
+        }
+    });
 
-        auto it1 = airports.find(destAirport);
-        if (it1 != airports.end()) {
-            destAirport = *it1;
+    size_t firstLine = file.getLineNumber();
+    for (const Chunk& chunk : chunks) {
+        for (const auto& error : chunk.errors) {
+            std::cerr << file.getPath() << ":" << firstLine + error.first << ": " << error.second << std::endl;
+        }
+        for (const ParsedFlight& flight : chunk.flights) {
+            g.addEdge(*flight.source, *flight.dest, flight.weight, std::string(flight.airline));
         }
+        firstLine += chunk.lines;
+    }
+}
+
+/**
+ * @brief Loads the whole network from the binary snapshot, if it is newer than the CSV files.
+ * @param diameter Receives the diameter stored in the snapshot.
+ * @param csr Receives the CSR form of the graph, read in place from the snapshot.
+ * @param stats Receives the statistics of the graph, read in place from the snapshot.
+ * @return True if the snapshot was used; false if the CSV files have to be loaded instead.
+ * @details Time complexity: O(V + E), where V is the number of airports and E the number of flights.
+ */
+bool LoadingFunctions::LoadSnapshot(int& diameter, CsrGraph& csr, AirportStats& stats) {
+    if (!Snapshot::IsUpToDate(SnapshotPath, SourcePaths)) {
+        return false;
+    }
+    if (!Snapshot::Load(SnapshotPath, airlines, diameter, csr, stats)) {
+        std::cerr << "Ignoring invalid snapshot " << SnapshotPath << std::endl;
+        return false;
+    }
+    for (int v = 0; v < csr.getNumVertex(); v++) {
+        airports.insert(csr.getAirport(v));
+    }
+    return true;
+}
 
-        double result = HaversineAlgorithm(sourceAirport.getLatitude(),sourceAirport.getLongitude(),destAirport.getLatitude(),destAirport.getLongitude());
-        g.addEdge(sourceAirport,destAirport,result,tokens[2]);
+/**
+ * @brief Regenerates the binary snapshot from a network loaded from the CSV files.
+ * @param diameter The diameter of the graph.
+ * @param csr The CSR form of the graph.
+ * @param stats The statistics of the graph.
+ * @details Time complexity: O(V + E), where V is the number of airports and E the number of flights.
+ */
+void LoadingFunctions::SaveSnapshot(int diameter, const CsrGraph& csr, const AirportStats& stats) {
+    if (!Snapshot::Save(SnapshotPath, airlines, diameter, csr, stats)) {
+        std::cerr << "Failed to write snapshot " << SnapshotPath << std::endl;
     }
-    file.close();
 }
 
-// O(logn) as inbuilt sqrt function is used
 /**
  * @brief Calculates the Haversine distance between two sets of latitude and longitude coordinates.
  * @param lat1 The latitude of the first point.
@@ -150,24 +237,9 @@ void LoadingFunctions::LoadFlights(Graph<Airport> &g) {
  * @param lat2 The latitude of the second point.
  * @param lon2 The longitude of the second point.
  * @return The Haversine distance between the two points.
- * @details Time complexity: O(log n) where n is the number that gets the square root calculated
+ * @details Forwards to Haversine::distance(). Time complexity: O(1)
  */
 double LoadingFunctions::HaversineAlgorithm(double lat1, double lon1,double lat2, double lon2)
 {
-    double dLat = (lat2 - lat1) *
-                  M_PI / 180.0;
-    double dLon = (lon2 - lon1) *
-                  M_PI / 180.0;
-
-    lat1 = (lat1) * M_PI / 180.0;
-    lat2 = (lat2) * M_PI / 180.0;
-
-
-    double a = pow(sin(dLat / 2), 2) +
-               pow(sin(dLon / 2), 2) *
-               cos(lat1) * cos(lat2);
-
-    double rad = 6371;
-    double c = 2 * asin(sqrt(a));
-    return rad * c;
+    return Haversine::distance(lat1, lon1, lat2, lon2);
 }
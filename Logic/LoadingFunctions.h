@@ -3,6 +3,8 @@
 
 #include "Graph.h"
 #include "Airport.h"
+#include "CsrGraph.h"
+#include "AirportStats.h"
 #include <unordered_set>
 
 /**
@@ -32,6 +34,25 @@ public:
      */
     static void LoadFlights(Graph<Airport>& g);
 
+    /**
+     * @brief Load the whole network from the binary snapshot, if it is newer than the CSV files.
+     * @param diameter Receives the diameter stored in the snapshot.
+     * @param csr Receives the CSR form of the graph, read in place from the snapshot.
+     * @param stats Receives the statistics of the graph, read in place from the snapshot.
+     * @return True if the snapshot was used; false if the CSV files have to be loaded instead.
+     * @details Time complexity: O(V + E), where V is the number of airports and E the number of flights.
+     */
+    static bool LoadSnapshot(int& diameter, CsrGraph& csr, AirportStats& stats);
+
+    /**
+     * @brief Regenerate the binary snapshot from a network loaded from the CSV files.
+     * @param diameter The diameter of the graph.
+     * @param csr The CSR form of the graph.
+     * @param stats The statistics of the graph.
+     * @details Time complexity: O(V + E), where V is the number of airports and E the number of flights.
+     */
+    static void SaveSnapshot(int diameter, const CsrGraph& csr, const AirportStats& stats);
+
     /**
      * @brief Normalize a string by converting it to lowercase.
      * @param str The string to normalize.
@@ -46,10 +67,6 @@ public:
      */
     static std::unordered_set<Airline> getAirlines() { return airlines; };
 
-private:
-    static std::unordered_set<Airport> airports;
-    static std::unordered_set<Airline> airlines;
-
     /**
      * @brief Calculate the Haversine distance between two sets of latitude and longitude coordinates.
      * @param lat1 The latitude of the first point.
@@ -57,9 +74,13 @@ private:
      * @param lat2 The latitude of the second point.
      * @param lon2 The longitude of the second point.
      * @return The Haversine distance between the two points.
-     * @details Time complexity: O(log n)
+     * @details Forwards to Haversine::distance(). Time complexity: O(1)
      */
     static double HaversineAlgorithm(double lat1, double lon1, double lat2, double lon2);
+
+private:
+    static std::unordered_set<Airport> airports;
+    static std::unordered_set<Airline> airlines;
 };
 
 #endif //PROJETO_2_LOADINGFUNCTIONS_H
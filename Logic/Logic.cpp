@@ -1,10 +1,49 @@
 #include "Logic.h"
+#include "Haversine.h"
 #include <cmath>
 #include <iostream>
 #include <climits>
 
 
-Logic::Logic(Graph<Airport>& g) : graph(g) {}
+/**
+ * @brief Builds an empty logic, with no airports, until a network is loaded.
+ * @details Time complexity: O(1)
+ */
+Logic::Logic() = default;
+
+/**
+ * @brief Builds the logic over a loaded graph, which it copies and does not keep.
+ * @param g The graph.
+ * @details Time complexity: O(V log V + F log D + K), for the CSR form, the indexes and the statistics.
+ */
+Logic::Logic(const Graph<Airport>& g) : csr(g), spatial(csr), attributes(csr), stats(csr) {}
+
+/**
+ * @brief Builds the logic over a CSR graph and statistics that were already computed, e.g. by a snapshot.
+ * @param csr The CSR form of the graph.
+ * @param stats The statistics of the graph.
+ * @details Time complexity: O(V log V + F + K), for the spatial and attribute indexes only.
+ */
+Logic::Logic(CsrGraph csr, AirportStats stats)
+        : csr(std::move(csr)), spatial(this->csr), attributes(this->csr), stats(std::move(stats)) {}
+
+/**
+ * @brief Gets the CSR form of the graph.
+ * @return The CSR graph.
+ * @details Time complexity: O(1)
+ */
+const CsrGraph& Logic::getCsrGraph() const {
+    return csr;
+}
+
+/**
+ * @brief Gets the precomputed statistics of every airport.
+ * @return The statistics table.
+ * @details Time complexity: O(1)
+ */
+const AirportStats& Logic::getAirportStats() const {
+    return stats;
+}
 
 /**
  * @brief Calculates the Haversine distance between two sets of latitude and longitude coordinates.
@@ -13,27 +52,11 @@ Logic::Logic(Graph<Airport>& g) : graph(g) {}
  * @param lat2 The latitude of the second point.
  * @param lon2 The longitude of the second point.
  * @return The Haversine distance between the two points.
- * @details Time complexity: O(log n)
+ * @details Forwards to Haversine::distance(). Time complexity: O(1)
  */
-double Logic::HaversineAlgorithm(double lat1, double lon1,double lat2, double lon2)
+double Logic::HaversineAlgorithm(double lat1, double lon1,double lat2, double lon2) const
 {
-    double dLat = (lat2 - lat1) *
-                  M_PI / 180.0;
-    double dLon = (lon2 - lon1) *
-                  M_PI / 180.0;
-
-    // convert to radians
-    lat1 = (lat1) * M_PI / 180.0;
-    lat2 = (lat2) * M_PI / 180.0;
-
-
-    double a = pow(sin(dLat / 2), 2) +
-               pow(sin(dLon / 2), 2) *
-               cos(lat1) * cos(lat2);
-
-    double rad = 6371;
-    double c = 2 * asin(sqrt(a));
-    return rad * c;
+    return Haversine::distance(lat1, lon1, lat2, lon2);
 }
 
 /**
@@ -41,8 +64,9 @@ double Logic::HaversineAlgorithm(double lat1, double lon1,double lat2, double lo
  * @details Time complexity: O(V), where V is the number of vertices (airports) in the graph.
  */
 void Logic::MapAirports(){
-    for(auto v: graph.getVertexSet()){
-        this->NamesToCodes[v->getInfo().getName()] = v->getInfo().getCode();
+    for(int v = 0; v < csr.getNumVertex(); v++){
+        const Airport& airport = csr.getAirport(v);
+        this->NamesToCodes[airport.getName()] = airport.getCode();
     }
 }
 
@@ -51,7 +75,7 @@ void Logic::MapAirports(){
  * @return The unordered map of airport names to codes.
  * @details Time complexity: O(1)
  */
-unordered_map<std::string , std::string> Logic::getNamesToCodes(){
+unordered_map<std::string , std::string> Logic::getNamesToCodes() const{
     return this->NamesToCodes;
 }
 
@@ -60,7 +84,7 @@ unordered_map<std::string , std::string> Logic::getNamesToCodes(){
  * @return The total number of airports and flights.
  * @details Time complexity: O(1)
  */
-int Logic::GlobalNumbers() {
+int Logic::GlobalNumbers() const {
     return GlobalNumberOfAirports() + GlobalNumberOfFlights();
 }
 
@@ -69,131 +93,80 @@ int Logic::GlobalNumbers() {
  * @return The total number of airports.
  * @details Time complexity: O(1)
  */
-int Logic::GlobalNumberOfAirports() {
-    return graph.getVertexSet().size();
+int Logic::GlobalNumberOfAirports() const {
+    return csr.getNumVertex();
 }
 
 /**
  * @brief Gets the global number of flights.
  * @return The total number of flights.
- * @details Time complexity: O(V), where V is the number of vertices (airports) in the graph.
+ * @details Time complexity: O(1)
  */
-size_t Logic::GlobalNumberOfFlights() {
-
-    size_t numberFlights = 0;
-
-    for(auto vertex : graph.getVertexSet())
-    {
-        numberFlights += vertex->getAdj().size();
-    }
-
-    return numberFlights;
+size_t Logic::GlobalNumberOfFlights() const {
+    return csr.getNumFlights();
 }
 
 /**
  * @brief Calculates the number of flights out of a specific airport with different airlines.
  * @param AirportCode The code of the airport.
  * @return A pair containing the number of flights and the number of different airlines.
- * @details Time complexity: O(E), where E is the number of edges (flights) in that Vertex of the graph.
+ * @details Time complexity: O(1) on average, a read of the statistics table.
  */
 std::pair<int , int>
-Logic::FlightsOutOfAirportAndDifferentAirlines(const std::string& AirportCode) {
-    int NumberOfFlights = 0;
-    unordered_set<std::string> AirlinesCodes;
+Logic::FlightsOutOfAirportAndDifferentAirlines(const std::string& AirportCode) const {
+    int v = csr.findVertex(AirportCode);
 
-    Airport tempAirport = Airport(AirportCode, " ", " ", " ", 0.0, 0.0);
-
-    Vertex<Airport>* flight = this->graph.findVertex(tempAirport);
-
-    if(flight == nullptr)
-    {
-        return std::make_pair(NumberOfFlights , (int) AirlinesCodes.size());
-    }
-
-    NumberOfFlights = static_cast<int>(flight->getAdj().size());
-
-    for(const auto& edge : flight->getAdj())
+    if(v == -1)
     {
-        AirlinesCodes.insert(edge.getAirline());
+        return std::make_pair(0 , 0);
     }
 
-    return std::make_pair(NumberOfFlights , (int) AirlinesCodes.size());
+    return std::make_pair(stats.getFlightsOut(v) , stats.getAirlines(v));
 }
 
 /**
  * @brief Calculates the number of flights for a specific airline.
  * @param airlineCode The code of the airline.
  * @return The number of flights for the specified airline.
- * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(1) on average, an index lookup.
  */
-int Logic::NumberOfFlightsPerAirline(const std::string& airlineCode) {
-    int NumberOfFlights = 0;
-
-    for(auto vertex : graph.getVertexSet())
-    {
-        for(auto edge : vertex->getAdj())
-        {
-            if(edge.getAirline() == airlineCode)
-            {
-                NumberOfFlights++;
-            }
-        }
-    }
-
-    return NumberOfFlights;
+int Logic::NumberOfFlightsPerAirline(const std::string& airlineCode) const {
+    return (int) attributes.airlineRoutes(StringPool::airlineCodes().find(airlineCode)).size();
 }
 
 /**
  * @brief Calculates the number of countries that flights from a specific airport fly to.
  * @param airportCode The code of the airport.
  * @return The number of countries.
- * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(1) on average, a read of the statistics table.
  */
-int Logic::NumberOfCountries(std::string airportCode) {
+int Logic::NumberOfCountries(std::string airportCode) const {
+    int v = csr.findVertex(airportCode);
 
-    unordered_set<std::string> countries;
-
-    Airport SearchAirport = Airport(airportCode);
-
-    Vertex<Airport>* airport = graph.findVertex(SearchAirport);
-
-    if(airport == NULL)
+    if(v == -1)
     {
         return 0;
     }
 
-    for(auto edge : airport->getAdj())
-    {
-        auto child = edge.getDest();
-        std::string country = child->getInfo().getCountry();
-        countries.insert(child->getInfo().getCountry());
-    }
-
-    return (int) countries.size();
+    return stats.getCountries(v);
 }
 
 /**
  * @brief Calculates the number of countries that flights from a specific city fly to.
  * @param city The city name.
  * @return The number of countries.
- * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(C + R), where C is the number of airports of cities with that name and R the number of
+ * routes out of them.
  */
-int Logic::NumberOfCountriesThatCityFliesTo(std::string city) {
+int Logic::NumberOfCountriesThatCityFliesTo(std::string city) const {
+    unordered_set<int> countries;
 
-    unordered_set<std::string> countries;
-
-    for(auto vertex : graph.getVertexSet())
+    for (int v : attributes.cityAirports(StringPool::cities().find(city)))
     {
-       auto airport = vertex->getInfo();
-
-       if(airport.getCity() == city)
-       {
-           for(auto edge : vertex->getAdj())
-           {
-               auto child = edge.getDest()->getInfo();
-               countries.insert(child.getCountry());
-           }
-       }
+        for (int e = csr.edgesBegin(v); e < csr.edgesEnd(v); e++)
+        {
+            countries.insert(csr.getAirport(csr.edgeDest(e)).getCountryId());
+        }
     }
 
     return (int) countries.size();
@@ -203,20 +176,14 @@ int Logic::NumberOfCountriesThatCityFliesTo(std::string city) {
  * @brief Calculates the number of flights departing from a specific city.
  * @param city The city name.
  * @return The number of flights.
- * @details Time complexity: O(V), where V is the number of vertices (airports) in the graph.
+ * @details Time complexity: O(C), where C is the number of airports of cities with that name.
  */
-int Logic::NumberOfFlightsPerCity(std::string city) {
-
+int Logic::NumberOfFlightsPerCity(std::string city) const {
     int numberFlights = 0;
 
-    for(auto vertex : graph.getVertexSet())
+    for (int v : attributes.cityAirports(StringPool::cities().find(city)))
     {
-        auto airport = vertex->getInfo();
-
-        if(vertex->getInfo().getCity() == city)
-        {
-            numberFlights += (int) vertex->getAdj().size();
-        }
+        numberFlights += csr.flightsOut(v);
     }
 
     return numberFlights;
@@ -228,88 +195,33 @@ int Logic::NumberOfFlightsPerCity(std::string city) {
  * @brief Calculates the number of unique destinations for flights departing from a specific airport.
  * @param airportCode The code of the airport.
  * @return The number of unique destinations.
- * @details Time complexity: O(V + E), where E is the number of edges (flights) in the graph and V the number of vertices.
+ * @details Time complexity: O(1) on average, a read of the statistics table.
  */
-int Logic::NumberOfDestinationsForAirport(const std::string& airportCode) {
-    Vertex<Airport> *sourceVertex = graph.findVertex(Airport(airportCode));
-
-    if (sourceVertex == nullptr) {
-        return 0;
-    }
-
-    int destinations = 0;
-    std::unordered_set<std::string> visitedDestinations;
-
-    for (const Edge<Airport>& edge : sourceVertex->getAdj()) {
-        Vertex<Airport>* neighbor = edge.getDest();
-
-        const std::string& destinationCode = neighbor->getInfo().getCode();
-        if (visitedDestinations.find(destinationCode) == visitedDestinations.end()) {
-            destinations++;
-            visitedDestinations.insert(destinationCode);
-        }
-    }
-
-    return destinations;
+int Logic::NumberOfDestinationsForAirport(const std::string& airportCode) const {
+    int v = csr.findVertex(airportCode);
+    return v == -1 ? 0 : stats.getDestinations(v);
 }
 
 /**
  * @brief Calculates the number of unique destinations reachable from the specified airport by direct flights.
  * @param airportCode The code of the airport to analyze.
- * @return The number of unique destinations reachable from the specified airport.
- * @details Time Complexity: O(E), where E is the number of edges in the graph.
+ * @return The number of unique destination cities reachable from the specified airport.
+ * @details Time complexity: O(1) on average, a read of the statistics table.
  */
-int Logic::NumberOfDestinationsForCity(const std::string& airportCode) {
-    Vertex<Airport> *sourceVertex = graph.findVertex(Airport(airportCode));
-
-    if (sourceVertex == nullptr) {
-        return 0;
-    }
-
-    int destinations = 0;
-    std::unordered_set<std::string> visitedDestinations;
-
-    for (const Edge<Airport>& edge : sourceVertex->getAdj()) {
-        Vertex<Airport>* neighbor = edge.getDest();
-
-        const std::string& cityName = neighbor->getInfo().getCity();
-        if (visitedDestinations.find(cityName) == visitedDestinations.end()) {
-            destinations++;
-            visitedDestinations.insert(cityName);
-        }
-    }
-
-    return destinations;
+int Logic::NumberOfDestinationsForCity(const std::string& airportCode) const {
+    int v = csr.findVertex(airportCode);
+    return v == -1 ? 0 : stats.getCities(v);
 }
 
-// O(V + E)
 /**
  * @brief Calculates the number of unique destinations (countries) for flights departing from a specific country.
  * @param airportCode The code of the airport.
  * @return The number of unique destinations.
- * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(1) on average, a read of the statistics table.
  */
-int Logic::NumberOfDestinationsForCountry(const std::string& airportCode) {
-    Vertex<Airport> *sourceVertex = graph.findVertex(Airport(airportCode));
-
-    if (sourceVertex == nullptr) {
-        return 0;
-    }
-
-    int destinations = 0;
-    std::unordered_set<std::string> visitedDestinations;
-
-    for (const Edge<Airport>& edge : sourceVertex->getAdj()) {
-        Vertex<Airport>* neighbor = edge.getDest();
-
-        const std::string& countryName = neighbor->getInfo().getCountry();
-        if (visitedDestinations.find(countryName) == visitedDestinations.end()) {
-            destinations++;
-            visitedDestinations.insert(countryName);
-        }
-    }
-
-    return destinations;
+int Logic::NumberOfDestinationsForCountry(const std::string& airportCode) const {
+    int v = csr.findVertex(airportCode);
+    return v == -1 ? 0 : stats.getCountries(v);
 }
 
 //||||||||||| Point 6 |||||||||||||||||||||||
@@ -320,42 +232,21 @@ int Logic::NumberOfDestinationsForCountry(const std::string& airportCode) {
  * @return A vector of airports at the specified distance.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-vector<Airport> Logic::nodesAtDistanceBFS(const string &airportCode, int k) {
+vector<Airport> Logic::nodesAtDistanceBFS(const string &airportCode, int k) const {
     vector<Airport> res;
 
-    Airport SearchAirport = Airport(airportCode);
-
-    Vertex<Airport>* airport = graph.findVertex(SearchAirport);
-
-    for (auto vertex : graph.getVertexSet()) {
-        vertex->setVisited(false);
+    int source = csr.findVertex(airportCode);
+    if (source == -1 || k < 0) {
+        return res;
     }
 
-    queue<Vertex<Airport>*> q;
-    q.push(airport);
-    airport->setVisited(true);
-
-    while (!q.empty() && k >= 0) {
-        int lvl_size = q.size();
-
-        while (lvl_size != 0) {
-            auto ver = q.front();
+    CsrGraph::ContextLease lease;
+    CsrGraph::QueryContext& context = *lease;
+    csr.bfs(source, context.dist, context.queue);
 
-            res.push_back(ver->getInfo());
-
-            for (auto edge : ver->getAdj()) {
-                auto destVert = edge.getDest();
-                if (!destVert->isVisited()) {
-                    q.push(destVert);
-                    destVert->setVisited(true);
-                }
-            }
-
-            lvl_size--;
-            q.pop();
-        }
-
-        k--;
+    // The queue holds the airports reached, in the order they were reached, so the levels up to k are a prefix
+    for (size_t i = 0; i < context.queue.size() && context.dist[context.queue[i]] <= k; i++) {
+        res.push_back(csr.getAirport(context.queue[i]));
     }
 
     return res;
@@ -367,17 +258,17 @@ vector<Airport> Logic::nodesAtDistanceBFS(const string &airportCode, int k) {
  * @return A vector containing the count of distinct airports, countries, and cities.
  * @details Time complexity: O(1).
  */
-vector<int> Logic::analyzeReachableAirports(const vector<Airport> &reachableAirports) {
+vector<int> Logic::analyzeReachableAirports(const vector<Airport> &reachableAirports) const {
     unordered_set<Airport> distinctAirports;
-    unordered_set<string> distinctCountries;
-    unordered_set<string> distinctCities;
+    unordered_set<int> distinctCountries;
+    unordered_set<int> distinctCities;
 
     vector<int> result;
 
     for (const auto &airport : reachableAirports) {
-        distinctAirports.insert(airport.getCode());
-        distinctCountries.insert(airport.getCountry());
-        distinctCities.insert(airport.getCity());
+        distinctAirports.insert(airport);
+        distinctCountries.insert(airport.getCountryId());
+        distinctCities.insert(airport.getCityId());
     }
 
     result.push_back(distinctAirports.size());
@@ -392,95 +283,62 @@ vector<int> Logic::analyzeReachableAirports(const vector<Airport> &reachableAirp
 //||||||||||||| Point 7 |||||||||||||||||||||
 
 /**
- * @brief Finds pairs of airports with the maximum distance between them.
- * @return A pair containing a vector of pairs of airports and the maximum distance.
- * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @brief Finds the pairs of airports farthest apart, the ones whose shortest trip takes the most flights.
+ * @return Every such pair as a Trip holding one of its shortest itineraries, and that number of flights (the diameter).
+ * @details The eccentricities come from one bit-parallel BFS from every airport, run on the thread pool, and each
+ * itinerary from a bidirectional BFS between its two airports.
+ * Time complexity: O(V / 64 * D * (V + E) + P * (V + E)), where V is the number of vertices (airports), E is the
+ * number of routes, D is the diameter and P is the number of pairs found.
  */
-void setUnvisited(Graph<Airport> g);
-void specialDFS(Vertex<Airport>* v);
-std::pair< std::vector<std::pair<Airport, Airport>> , int> Logic::AirportAtMaximumDistance() {
-
-    std::vector<std::pair<Airport, Airport>> res = {};
-
-    unordered_map<int , std::vector<std::pair<Airport , Airport>>> map;
-
-    Airport initialAirport = Airport();
-    Airport endAirport = Airport();
-
-    for(auto vertex : graph.getVertexSet())
-    {
-        initialAirport = vertex->getInfo();
-        setUnvisited(this->graph);
-        specialDFS(vertex);
-
-        int max = INT16_MIN;
-        for(auto vertex1 : graph.getVertexSet())
-        {
-            if(vertex1->getNum() > max)
-            {
-                max = vertex1->getNum();
-                endAirport = vertex1->getInfo();
-            }
-        }
+std::pair<std::vector<Trip>, int> Logic::AirportAtMaximumDistance() const {
+    CsrGraph::HopSummary summary = csr.allSourcesBfs();
+    LongestTripList trips(csr, summary.farthestPairs, summary.diameter);
 
-        if(map.find(max) == map.end())
-        {
-            map[max] = {std::make_pair(initialAirport , endAirport)};
-        }
-        else
-        {
-            map[max].emplace_back(initialAirport , endAirport);
-        }
-    }
-
-    int max = INT16_MIN;
-    for(auto a : map)
-    {
-        if(a.first > max) max = a.first;
-    }
-
-    for(auto a : map)
-    {
-        if(a.first == max)
-        {
-            for(const auto& pair : a.second)
-            {
-                res.push_back(pair);
-            }
+    std::vector<Trip> res;
+    for (size_t i = 0; i < trips.size(); i++) {
+        Trip trip;
+        trip.airports = trips.itinerary(i);
+        for (size_t j = 1; j < trip.airports.size(); j++) {
+            trip.kilometres += HaversineAlgorithm(trip.airports[j - 1].getLatitude(), trip.airports[j - 1].getLongitude(),
+                                                  trip.airports[j].getLatitude(), trip.airports[j].getLongitude());
         }
+        trip.flights = summary.diameter;
+        res.push_back(trip);
     }
 
-    return std::make_pair(res , max);
+    return std::make_pair(res, summary.diameter);
 }
 
 /**
- * @brief Performs a special Depth-First Search (DFS) to set numerical values for vertices.
- * @param v The starting vertex.
+ * @brief Finds the pairs of airports whose shortest trip takes a given number of flights.
+ * @param diameter The number of flights, normally the diameter of the network.
+ * @return The pairs; their itineraries are only searched for when asked.
+ * @details One bit-parallel sweep from every airport runs on the thread pool and keeps only the pairs at that
+ * distance. Time complexity: O(V / 64 * D * (V + E) + P), where D is the given distance and P the number of pairs.
  */
-void specialDFS(Vertex<Airport>* v)
-{
-    v->setVisited(true);
-    for (auto & e : v->getAdj()) {
-        auto w = e.getDest();
-        if ( ! w->isVisited()) {
-            w->setNum(v->getNum() + 1);
-            specialDFS(w);
-        }
-    }
+LongestTripList Logic::LongestTrips(int diameter) const {
+    return LongestTripList(csr, csr.pairsAtDistance(diameter), diameter);
 }
 
 /**
- * @brief Sets all vertices in the graph as unvisited.
- * @param g The graph.
- * @details O(V) where V is the number of vertces on the graph
+ * @brief Finds one shortest trip between the two airports of a pair.
+ * @param i The position of the pair, sorted by origin.
+ * @return The airports of the trip, from the origin to the destination.
+ * @details Runs a bidirectional BFS in a query context leased from the calling thread. Time complexity: O(V + E)
  */
-void setUnvisited(Graph<Airport> g)
-{
-    for(auto& vertex : g.getVertexSet())
-    {
-        vertex->setVisited(false);
-        vertex->setNum(0);
+vector<Airport> LongestTripList::itinerary(size_t i) const {
+    CsrGraph::ContextLease context;
+    graph->bidirectionalBfs(pairs[i].first, pairs[i].second, AnyRoute(), context->hop);
+    CsrGraph::HopRouteIterator<AnyRoute> routes = graph->bidirectionalRoutes(AnyRoute(), std::move(context), 1);
+
+    vector<int> route;
+    routes.next(route);
+    vector<Airport> res;
+    res.reserve(route.size());
+    for (int v : route) {
+        res.push_back(graph->getAirport(v));
     }
+    return res;
 }
 
 /**
@@ -490,49 +348,46 @@ void setUnvisited(Graph<Airport> g)
  * @return A vector of vectors representing the maximum trips.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-vector<vector<Airport>> Logic::FindMaxTripBfs(const Airport &airport_, int diameter) {
+vector<vector<Airport>> Logic::FindMaxTripBfs(const Airport &airport_, int diameter) const {
     vector<vector<Airport>> res;
 
-    Vertex<Airport>* airportVertex = graph.findVertex(airport_);
+    int source = csr.findVertex(airport_.getCode());
 
-    if(airportVertex == nullptr)
+    if(source == -1)
     {
         return {};
     }
 
-    for (auto vertex : graph.getVertexSet()) {
-        vertex->setVisited(false);
-        vertex->setNum(0);
-        vertex->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport>*> q;
-    q.push(airportVertex);
-    airportVertex->setVisited(true);
-    airportVertex->setNum(0);
-    airportVertex->setParent(nullptr);
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-        if(v->getNum() == diameter)
+    CsrGraph::ContextLease lease;
+    CsrGraph::QueryContext& context = *lease;
+    StampedArray<int>& num = context.dist;
+    vector<int>& parent = context.parent;
+    vector<int>& q = context.queue;
+    num.reset(csr.getNumVertex());
+    parent.resize(csr.getNumVertex());
+    q.clear();
+
+    q.push_back(source);
+    num.set(source, 0);
+    parent[source] = -1;
+    for (size_t head = 0; head < q.size(); head++) {
+        int v = q[head];
+        if(num[v] == diameter)
         {
             vector<Airport> temp;
-            temp.push_back(v->getInfo());
-            while (v->getParent() != nullptr)
+            for (int u = v; u != -1; u = parent[u])
             {
-                temp.push_back(v->getParent()->getInfo());
-                v = v->getParent();
+                temp.push_back(csr.getAirport(u));
             }
             std::reverse(temp.begin(), temp.end());
             res.push_back(temp);
         }
-        for (auto & e : v->getAdj()) {
-            auto w = e.getDest();
-            if ( ! w->isVisited() ) {
-                q.push(w);
-                w->setVisited(true);
-                w->setParent(v);
-                w ->setNum(v->getNum() +1);
+        for (int e = csr.edgesBegin(v); e < csr.edgesEnd(v); e++) {
+            int w = csr.edgeDest(e);
+            if (num[w] < 0) {
+                q.push_back(w);
+                parent[w] = v;
+                num.set(w, num[v] + 1);
             }
         }
     }
@@ -545,22 +400,16 @@ vector<vector<Airport>> Logic::FindMaxTripBfs(const Airport &airport_, int diame
  * @brief Finds the airports with the greatest in-degrees.
  * @param k The number of airports to find.
  * @return A vector of airport codes with the greatest in-degrees.
- * @details Time complexity: O(V*log(V) + V*E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V*log(V)), where V is the number of vertices (airports); the in-degrees come from the statistics table.
  */
-vector<string> Logic::GreatestKIndeegrees(int k) {
+vector<string> Logic::GreatestKIndeegrees(int k) const {
     vector<std::pair<int, std::string>> airport_to_traffic;
-    vector<int> traffics;
     vector<string> result;
-    size_t s;
-    graph.calculateIndegrees();
-    for(auto vertex: graph.getVertexSet()){
-        s = vertex->getIndegree();
-        traffics.push_back(s);
-        airport_to_traffic.push_back(std::make_pair(s, vertex->getInfo().getCode()));
+    for(int v = 0; v < csr.getNumVertex(); v++){
+        airport_to_traffic.push_back(std::make_pair(stats.getFlightsIn(v), csr.getAirport(v).getCode()));
     }
-    std::sort(traffics.begin(), traffics.end(), greater<int>());
     std::sort(airport_to_traffic.rbegin(), airport_to_traffic.rend());
-    for (int i = 0; i < k; i++){
+    for (int i = 0; i < k && i < (int) airport_to_traffic.size(); i++){
         result.push_back(airport_to_traffic[i].second);
         std::cout << i+1 << ". " << airport_to_traffic[i].second << " " << airport_to_traffic[i].first << endl;
     }
@@ -573,156 +422,207 @@ vector<string> Logic::GreatestKIndeegrees(int k) {
  * @return An unordered set of airports representing the articulation points.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-unordered_set<Airport> Logic::findArticulationPoints() {
-    int index = 1;
-    unordered_set<Airport> articulationPoints;
-    stack<Vertex<Airport>*> s;
-
-    for (Vertex<Airport>* v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setProcessing(false);
-    }
-
-    for (Vertex<Airport>* v : graph.getVertexSet()) {
-        if (!v->isVisited()) {
-            dfs_articulationPoints(v, articulationPoints, s, index);
-        }
-    }
-
-    return articulationPoints;
+unordered_set<Airport> Logic::findArticulationPoints() const {
+    return csr.findArticulationPoints();
 }
 
-// Helper function for findArticulationPoints
-void Logic::dfs_articulationPoints(Vertex<Airport>* v, unordered_set<Airport>& articPoints, stack<Vertex<Airport>*>& s, int& index) {
-    v->setNum(index);
-    v->setLow(index);
-    v->setVisited(true);
-    index++;
-
-    s.push(v);
-    v->setProcessing(true);
-
-    int children = 0;
-    bool isArticulationPoint = false;
-
-    for (auto &e : v->getAdj()) {
-        Vertex<Airport>* w = e.getDest();
-        if (!w->isVisited()) {
-            children++;
-            dfs_articulationPoints(w, articPoints, s, index);
-            v->setLow(min(v->getLow(), w->getLow()));
-
-            if (w->getLow() >= v->getNum()) {
-                isArticulationPoint = true;
-            }
-        } else if (w->isProcessing()) {
-            v->setLow(min(v->getLow(), w->getNum()));
-        }
-    }
-
-    if ((v->getNum() == v->getLow() && children > 1) || (v->getNum() != v->getLow() && isArticulationPoint)) {
-        articPoints.insert(v->getInfo());
-
-        while (!s.empty()) {
-            Vertex<Airport>* poppedVertex = s.top();
-            s.pop();
-            poppedVertex->setProcessing(false);
-
-            if (poppedVertex == v) {
-                break;
-            }
-        }
-    }
-
+/**
+ * @brief Calculates the diameter of the network, the greatest number of flights on a shortest trip.
+ * @return The diameter of the graph.
+ * @details Time complexity: O(k * (V + E)), where k is the number of BFS runs CsrGraph::findDiameter() needs to
+ * prove the bound (O(V) in the worst case), V is the number of vertices (airports) and E the number of routes.
+ */
+int Logic::calculateDiameter() const {
+    return csr.calculateDiameter();
 }
 
 
 //|||||||||||||||||||||||||| ShortestPath ||||||||||||||||||||||||||
 /**
- * @brief Finds the shortest path between two airports using Breadth-First Search (BFS).
+ * @brief Finds the shortest path between two airports using a bidirectional Breadth-First Search (BFS).
  * @param initialAirport The starting airport.
  * @param destAirport The destination airport.
  * @return A vector of airports representing the shortest path.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-vector<Airport> Logic::shortestPath(const Airport& initialAirport, const Airport& destAirport) {
+vector<Airport> Logic::shortestPath(const Airport& initialAirport, const Airport& destAirport) const {
     vector<Airport> res;
-    Vertex<Airport>* initialVertex;
-    Vertex<Airport>* finalVertex;
+    int source = csr.findVertex(initialAirport.getCode());
+    int target = csr.findVertex(destAirport.getCode());
 
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-        if(v->getInfo() == destAirport)
-        {
-            finalVertex = v;
+    if (source == -1 || target == -1)
+        return res;  // Return an empty vector indicating failure
+
+    CsrGraph::ContextLease context;
+    csr.bidirectionalBfs(source, target, AnyRoute(), context->hop);
+    CsrGraph::HopRouteIterator<AnyRoute> routes = csr.bidirectionalRoutes(AnyRoute(), std::move(context), 1);
+    vector<int> route;
+    if (routes.next(route)) {
+        for (int v : route) {
+            res.push_back(csr.getAirport(v));
         }
     }
+    return res;  // Empty if no path was found
+}
+/**
+ * @brief Finds the closest airports to a given location specified by latitude and longitude.
+ * @param Latitude The latitude of the location.
+ * @param Longitude The longitude of the location.
+ * @return A vector of airports closest to the specified location, every one tied at the smallest distance.
+ * @details Time complexity: O(log V) on average, where V is the number of vertices (airports) in the graph.
+ */
+vector<Airport> Logic::FindClosestAirportsToLocation(double Latitude, double Longitude) const{
+    vector<Airport> res;
+    for (int v : spatial.nearest(Latitude, Longitude)) {
+        res.push_back(csr.getAirport(v));
+    }
+    return res;
+}
 
-    if (initialVertex == nullptr || finalVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
+/**
+ * @brief Finds the airports a trip from or to a location may use.
+ * @param Latitude The latitude of the location.
+ * @param Longitude The longitude of the location.
+ * @return Every airport within the location radius, sorted as in the graph; the closest airports if none is that near.
+ * @details Time complexity: O(log V + R) on average, where R is the number of airports in range.
+ */
+vector<Airport> Logic::AirportsNearLocation(double Latitude, double Longitude) const {
+    AirportIds ids = LocationAirports(Latitude, Longitude);
+    vector<Airport> res;
+    for (size_t i = 0; i < ids.size(); i++) {
+        res.push_back(csr.getAirport(ids[i]));
+    }
+    return res;
+}
 
-    // Resetting visited and parent information
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
+/**
+ * @brief Selects the airports a trip from or to a location may use.
+ * @param latitude The latitude of the location.
+ * @param longitude The longitude of the location.
+ * @return Every airport within the location radius; the closest airports if none is that near.
+ * @details Time complexity: O(log V + R) on average, where R is the number of airports in range.
+ */
+AirportIds Logic::LocationAirports(double latitude, double longitude) const {
+    vector<int> ids = spatial.withinRadius(latitude, longitude, locationRadius);
+    if (ids.empty()) {
+        ids = spatial.nearest(latitude, longitude);
     }
+    return AirportIds(std::move(ids));
+}
 
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
+/**
+ * @brief Sets how far from a location the airports its trips start or end at may be.
+ * @param kilometres The radius; 0 keeps only the airports closest to the location.
+ * @details Time complexity: O(1)
+ */
+void Logic::setLocationRadius(double kilometres) {
+    locationRadius = kilometres;
+}
 
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
+/**
+ * @brief Gets how far from a location the airports its trips start or end at may be.
+ * @return The radius in kilometres; 0 when only the closest airports are used.
+ * @details Time complexity: O(1)
+ */
+double Logic::getLocationRadius() const {
+    return locationRadius;
+}
 
-        if (v == finalVertex) {
-            // Reconstruct the path
-            while (v->getParent() != nullptr) {
-                res.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            res.push_back(initialAirport);  // Add the initial vertex to the path
-            reverse(res.begin(), res.end());  // Reverse the path to get correct order
-            return res;
+/**
+ * @brief Gets every airport located in a city.
+ * @param city The city.
+ * @param country The country where the city is located.
+ * @return The airports of the city, sorted as in the graph.
+ * @details Time complexity: O(C), where C is the number of airports of cities with that name.
+ */
+vector<Airport> Logic::AirportsInCity(const std::string& city, const std::string& country) const {
+    int countryId = StringPool::countries().find(country);
+    vector<Airport> res;
+    for (int v : attributes.cityAirports(StringPool::cities().find(city))) {
+        const Airport& airport = csr.getAirport(v);
+        if (airport.getCountryId() == countryId) {
+            res.push_back(airport);
         }
+    }
+    return res;
+}
 
-        for (const Edge<Airport> &e : v->getAdj()) {
-            Vertex<Airport>* w = e.getDest();
-            if (!w->isVisited()) {
-                w->setParent(v);
-                q.push(w);
-                w->setVisited(true);
-            }
-        }
+/**
+ * @brief Gets every airport located in a country.
+ * @param country The country.
+ * @return The airports of the country, sorted as in the graph.
+ * @details Time complexity: O(C), where C is the number of airports of the country.
+ */
+vector<Airport> Logic::AirportsInCountry(const std::string& country) const {
+    vector<Airport> res;
+    for (int v : attributes.countryAirports(StringPool::countries().find(country))) {
+        res.push_back(csr.getAirport(v));
     }
+    return res;
+}
 
-    return res;  // Return an empty vector indicating that no path was found
+/**
+ * @brief Tells whether some airport is in a city with the given name.
+ * @param city The city name.
+ * @return True if the city has an airport.
+ * @details Time complexity: O(1) on average.
+ */
+bool Logic::IsCity(const std::string& city) const {
+    return !attributes.cityAirports(StringPool::cities().find(city)).empty();
 }
+
 /**
- * @brief Finds the closest airports to a given location specified by latitude and longitude.
- * @param Latitude The latitude of the location.
- * @param Longitude The longitude of the location.
- * @return A vector of airports closest to the specified location.
- * @details Time complexity: O(V), where V is the number of vertices (airports) in the graph.
+ * @brief Tells whether an airport with the given code is in the graph.
+ * @param airportCode The airport code.
+ * @return True if the airport exists.
+ * @details Time complexity: O(1) on average.
  */
-vector<Airport> Logic::FindClosestAirportsToLocation(double Latitude, double Longitude){
-    vector<Airport> res;
-    double min_distance = numeric_limits<double>::max();
-    for(auto v: graph.getVertexSet()){
-        Airport temp = v->getInfo();
-        double dist = HaversineAlgorithm(Latitude, Longitude, temp.getLatitude(), temp.getLongitude());
-        if(dist < min_distance){
-            res.clear();
-            min_distance = dist;
-        }
-        if(dist == min_distance){
-            res.push_back(temp);
-        }
+bool Logic::IsAirport(const std::string& airportCode) const {
+    return csr.findVertex(airportCode) != -1;
+}
+
+/**
+ * @brief Finds the trip with the fewest kilometres from any of the origins to any of the destinations.
+ * @param origins The airports the trip may start from, e.g. AirportsInCity() or AirportsNearLocation().
+ * @param destinations The airports the trip may end at.
+ * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
+ * @param airlines Set of airlines to avoid or include based on the choice.
+ * @param useAStar Whether to guide the search with the great-circle distance to the destinations (A*) instead of
+ * running plain Dijkstra; both find a trip of the same length.
+ * @return The shortest trip, with its length in kilometres, its number of flights and the number of airports the
+ * search settled; the airports are empty if no destination can be reached.
+ * @details Time complexity: O((V + E) log E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ */
+Trip Logic::ShortestDistanceTrip(const vector<Airport>& origins, const vector<Airport>& destinations, int choice,
+                                 const unordered_set<std::string>& airlines, bool useAStar) const {
+    vector<int> sources;
+    vector<int> targets;
+    for (const Airport& airport : origins) {
+        int v = csr.findVertex(airport.getCode());
+        if (v != -1) sources.push_back(v);
+    }
+    for (const Airport& airport : destinations) {
+        int v = csr.findVertex(airport.getCode());
+        if (v != -1) targets.push_back(v);
+    }
+
+    AirlineFilter filter(choice, airlines);
+
+    Trip res;
+    CsrGraph::ContextLease context;
+    CsrGraph::SearchBuffers& buffers = context->route;
+    int target = useAStar ? csr.aStar(sources, targets, filter, buffers)
+                          : csr.dijkstra(sources, targets, filter, buffers);
+    res.settled = buffers.settled;
+    if (target == -1) {
+        return res;
+    }
+
+    for (int v : csr.route(target, buffers)) {
+        res.airports.push_back(csr.getAirport(v));
     }
+    res.kilometres = buffers.dist[target];
+    res.flights = buffers.hops[target];
     return res;
 }
 
@@ -734,15 +634,9 @@ vector<Airport> Logic::FindClosestAirportsToLocation(double Latitude, double Lon
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToAirport(double source_latitude, double source_longitude, Airport dest){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToAirport(airport, dest)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToAirport(double source_latitude, double source_longitude, Airport dest) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      AirportIds(csr, {dest}), 1, {});
 }
 
 /**
@@ -754,15 +648,9 @@ list<vector<Airport>> Logic::LocationToAirport(double source_latitude, double so
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToCity(double source_latitude, double source_longitude, const std::string city, const std::string& country){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCity(airport, city, country)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCity(double source_latitude, double source_longitude, const std::string city, const std::string& country) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CityAirports(attributes, city, country), 1, {});
 }
 
 /**
@@ -773,15 +661,9 @@ list<vector<Airport>> Logic::LocationToCity(double source_latitude, double sourc
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToCountry(double source_latitude, double source_longitude, const std::string country){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCountry(airport, country)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCountry(double source_latitude, double source_longitude, const std::string country) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CountryAirports(attributes, country), 1, {});
 }
 
 /**
@@ -792,15 +674,9 @@ list<vector<Airport>> Logic::LocationToCountry(double source_latitude, double so
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToLocation(Airport source, double dest_latitude, double dest_longitude){
-    vector<Airport> destinies = FindClosestAirportsToLocation(dest_latitude, dest_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: destinies){
-        for(auto trip: AirportToAirport(source, airport)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::AirportToLocation(Airport source, double dest_latitude, double dest_longitude) const{
+    return RouteTrips(AirportIds(csr, {source}),
+                      LocationAirports(dest_latitude, dest_longitude), 1, {});
 }
 /**
  * @brief Finds trips from the specified city in the given country to the given location.
@@ -811,16 +687,9 @@ list<vector<Airport>> Logic::AirportToLocation(Airport source, double dest_latit
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::CityToLocation(const std::string city, const std::string country, double dest_latitude, double dest_longitude){
-    vector<Airport> destinies = FindClosestAirportsToLocation(dest_latitude, dest_longitude);
-    list<vector<Airport>> res;
-    unordered_set<std::string> airline_names;
-    for(auto airport: destinies){
-        for(auto trip: CityToAirport(airport, city, country, 1, airline_names)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::CityToLocation(const std::string city, const std::string country, double dest_latitude, double dest_longitude) const{
+    return RouteTrips(CityAirports(attributes, city, country),
+                      LocationAirports(dest_latitude, dest_longitude), 1, {});
 }
 /**
  * @brief Finds trips from the given location to the destination airport, considering airline filters.
@@ -831,14 +700,9 @@ list<vector<Airport>> Logic::CityToLocation(const std::string city, const std::s
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToAirportAirlineOnlyFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToAirportAirlineOnlyFilters(airport, dest, airlines))
-            res.push_back(trip);
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToAirportAirlineOnlyFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      AirportIds(csr, {dest}), 3, airlines);
 }
 /**
  * @brief Finds trips from the given location to the destination airport, avoiding specified airlines.
@@ -849,14 +713,9 @@ list<vector<Airport>> Logic::LocationToAirportAirlineOnlyFilters(double source_l
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToAirportAirlineAvoidFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToAirportAirlineAvoidFilters(airport, dest, airlines))
-            res.push_back(trip);
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToAirportAirlineAvoidFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      AirportIds(csr, {dest}), 2, airlines);
 }
 /**
  * @brief Finds trips from the given location to the specified city in the given country, considering airline filters.
@@ -868,14 +727,9 @@ list<vector<Airport>> Logic::LocationToAirportAirlineAvoidFilters(double source_
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToCityAirlineOnlyFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCityAirlineOnlyFilter(airport, city, country, airlines))
-            res.push_back(trip);
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCityAirlineOnlyFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CityAirports(attributes, city, country), 3, airlines);
 }
 /**
  * @brief Finds trips from the given location to the specified city in the given country, avoiding specified airlines.
@@ -887,14 +741,9 @@ list<vector<Airport>> Logic::LocationToCityAirlineOnlyFilters(double source_lati
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToCityAirlineAvoidFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCityAirlineAvoidFilter(airport, city, country, airlines))
-            res.push_back(trip);
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCityAirlineAvoidFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CityAirports(attributes, city, country), 2, airlines);
 }
 /**
  * @brief Finds trips from the given location to the specified country, considering airline filters.
@@ -905,15 +754,9 @@ list<vector<Airport>> Logic::LocationToCityAirlineAvoidFilters(double source_lat
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::LocationToCountryAirlineOnlyFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCountryAirlineOnlyFilter(airport, country, airlines)) {
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCountryAirlineOnlyFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CountryAirports(attributes, country), 3, airlines);
 }
 /**
 * @brief Finds trips from the given location to the specified country, avoiding specified airlines.
@@ -924,15 +767,9 @@ list<vector<Airport>> Logic::LocationToCountryAirlineOnlyFilter(double source_la
 * @return A vector of trips, each represented as a vector of airports.
 * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
 */
-list<vector<Airport>> Logic::LocationToCountryAirlineAvoidFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines){
-    vector<Airport> sources = FindClosestAirportsToLocation(source_latitude, source_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: sources){
-        for(auto trip: AirportToCountryAirlineAvoidFilter(airport, country, airlines)) {
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::LocationToCountryAirlineAvoidFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines) const{
+    return RouteTrips(LocationAirports(source_latitude, source_longitude),
+                      CountryAirports(attributes, country), 2, airlines);
 }
 /**
  * @brief Finds trips from the specified airport to the given location, considering airline filters.
@@ -943,15 +780,9 @@ list<vector<Airport>> Logic::LocationToCountryAirlineAvoidFilter(double source_l
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToLocationAirlineOnlyFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline){
-    vector<Airport> destinies = FindClosestAirportsToLocation(dest_latitude, dest_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: destinies){
-        for(auto trip: AirportToAirportAirlineOnlyFilters(source, airport, airline)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::AirportToLocationAirlineOnlyFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline) const{
+    return RouteTrips(AirportIds(csr, {source}),
+                      LocationAirports(dest_latitude, dest_longitude), 3, airline);
 }
 /**
  * @brief Finds trips from the specified airport to the given location, avoiding specified airlines.
@@ -962,15 +793,9 @@ list<vector<Airport>> Logic::AirportToLocationAirlineOnlyFilters(Airport source,
  * @return A vector of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToLocationAirlineAvoidFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline){
-    vector<Airport> destinies = FindClosestAirportsToLocation(dest_latitude, dest_longitude);
-    list<vector<Airport>> res;
-    for(auto airport: destinies){
-        for(auto trip: AirportToAirportAirlineAvoidFilters(source, airport, airline)){
-            res.push_back(trip);
-        }
-    }
-    return res;
+list<vector<Airport>> Logic::AirportToLocationAirlineAvoidFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline) const{
+    return RouteTrips(AirportIds(csr, {source}),
+                      LocationAirports(dest_latitude, dest_longitude), 2, airline);
 }
 
 //|||||||||||||||||| FILTERS ||||||||||||||||||
@@ -981,63 +806,8 @@ list<vector<Airport>> Logic::AirportToLocationAirlineAvoidFilters(Airport source
  * @return A list of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToAirport(const Airport& initialAirport, const Airport& destAirport) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-    Vertex<Airport>* finalVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-        if(v->getInfo() == destAirport)
-        {
-            finalVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr || finalVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v == finalVertex) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-
-            Vertex<Airport>* w = e.getDest();
-            if (!w->isVisited()) {
-                w->setParent(v);
-                q.push(w);
-                w->setVisited(true);
-            }
-
-        }
-    }
-
-    return res;
+list<vector<Airport>> Logic::AirportToAirport(const Airport& initialAirport, const Airport& destAirport) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), AirportIds(csr, {destAirport}), 1, {});
 }
 /**
  * @brief Finds trips from the specified airport to the given airport, considering airline filters.
@@ -1048,69 +818,8 @@ list<vector<Airport>> Logic::AirportToAirport(const Airport& initialAirport, con
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
 list<vector<Airport>>
-Logic::AirportToAirportAirlineOnlyFilters(const Airport& initialAirport, const Airport& destAirport, unordered_set<std::string> airlines) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-    Vertex<Airport>* finalVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-        if(v->getInfo() == destAirport)
-        {
-            finalVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr || finalVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v == finalVertex) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-            for(auto strig : airlines)
-            {
-                string temp1 = strig;
-            }
-            if(airlines.find(e.getAirline()) != airlines.end())
-            {
-                string temp = e.getAirline();
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+Logic::AirportToAirportAirlineOnlyFilters(const Airport& initialAirport, const Airport& destAirport, unordered_set<std::string> airlines) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), AirportIds(csr, {destAirport}), 3, airlines);
 }
 /**
  * @brief Finds trips from the specified airport to the given airport, avoiding specified airlines.
@@ -1122,68 +831,8 @@ Logic::AirportToAirportAirlineOnlyFilters(const Airport& initialAirport, const A
  */
 list<vector<Airport>>
 Logic::AirportToAirportAirlineAvoidFilters(const Airport &initialAirport, const Airport &destAirport,
-                                           unordered_set<std::string> airlines) {
-    for(auto string_ : airlines)
-    {
-        string temp = string_;
-    }
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-    Vertex<Airport>* finalVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-        if(v->getInfo() == destAirport)
-        {
-            finalVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr || finalVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v == finalVertex) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-            if(airlines.find(e.getAirline()) == airlines.end())
-            {
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+                                           unordered_set<std::string> airlines) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), AirportIds(csr, {destAirport}), 2, airlines);
 }
 
 /**
@@ -1194,56 +843,8 @@ Logic::AirportToAirportAirlineAvoidFilters(const Airport &initialAirport, const
  * @return A list of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToCity(const Airport& initialAirport, const std::string& city ,const std::string& country) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCity() == city && v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-            Vertex<Airport>* w = e.getDest();
-            if (!w->isVisited()) {
-                w->setParent(v);
-                q.push(w);
-                w->setVisited(true);
-            }
-        }
-    }
-
-    return res;
+list<vector<Airport>> Logic::AirportToCity(const Airport& initialAirport, const std::string& city ,const std::string& country) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), CityAirports(attributes, city, country), 1, {});
 }
 /**
  * @brief Finds trips from the specified airport to the given city in the given country, avoiding specified airlines.
@@ -1255,60 +856,8 @@ list<vector<Airport>> Logic::AirportToCity(const Airport& initialAirport, const
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
 list<vector<Airport>> Logic::AirportToCityAirlineAvoidFilter(const Airport& initialAirport, const std::string& city,
-                                                          const std::string& country , unordered_set<std::string> airlines) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCity() == city && v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-
-            if(airlines.find(e.getAirline()) == airlines.end())
-            {
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+                                                          const std::string& country , unordered_set<std::string> airlines) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), CityAirports(attributes, city, country), 2, airlines);
 }
 /**
  * @brief Finds trips from the specified airport to the given city in the given country, considering airline filters.
@@ -1321,60 +870,8 @@ list<vector<Airport>> Logic::AirportToCityAirlineAvoidFilter(const Airport& init
  */
 list<vector<Airport>>
 Logic::AirportToCityAirlineOnlyFilter(const Airport& initialAirport, const std::string& city, const std::string& country,
-                                      unordered_set<std::string> airlines) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCity() == city && v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-
-            if(airlines.find(e.getAirline()) != airlines.end())
-            {
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+                                      unordered_set<std::string> airlines) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), CityAirports(attributes, city, country), 3, airlines);
 }
 
 
@@ -1386,56 +883,8 @@ Logic::AirportToCityAirlineOnlyFilter(const Airport& initialAirport, const std::
  * @return A list of trips, each represented as a vector of airports.
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
-list<vector<Airport>> Logic::AirportToCountry(const Airport& initialAirport, const std::string& country) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-            Vertex<Airport>* w = e.getDest();
-            if (!w->isVisited()) {
-                w->setParent(v);
-                q.push(w);
-                w->setVisited(true);
-            }
-        }
-    }
-
-    return res;
+list<vector<Airport>> Logic::AirportToCountry(const Airport& initialAirport, const std::string& country) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), CountryAirports(attributes, country), 1, {});
 }
 /**
  * @brief Finds trips from the specified airport to the given country, avoiding specified airlines.
@@ -1446,60 +895,8 @@ list<vector<Airport>> Logic::AirportToCountry(const Airport& initialAirport, con
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
 list<vector<Airport>> Logic::AirportToCountryAirlineAvoidFilter(Airport initialAirport, std::string country,
-                                                                  unordered_set<std::string> airlines) {
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-
-            if(airlines.find(e.getAirline()) == airlines.end())
-            {
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+                                                                  unordered_set<std::string> airlines) const {
+    return RouteTrips(AirportIds(csr, {initialAirport}), CountryAirports(attributes, country), 2, airlines);
 }
 /**
  * @brief Finds trips from the specified airport to the given country, considering airline filters.
@@ -1510,60 +907,8 @@ list<vector<Airport>> Logic::AirportToCountryAirlineAvoidFilter(Airport initialA
  * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
  */
 list<vector<Airport>> Logic::AirportToCountryAirlineOnlyFilter(Airport initialAirport, std::string country,
-                                                                 unordered_set<std::string> airlines){
-    list<vector<Airport>> res;
-    Vertex<Airport>* initialVertex;
-
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo() == initialAirport)
-        {
-            initialVertex = v;
-        }
-    }
-
-    if (initialVertex == nullptr)
-        return res;  // Return an empty vector indicating failure
-
-    for (auto v : graph.getVertexSet()) {
-        v->setVisited(false);
-        v->setParent(nullptr);
-    }
-
-    queue<Vertex<Airport> *> q;
-    q.push(initialVertex);
-    initialVertex->setVisited(true);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        if (v->getInfo().getCountry() == country) {
-            vector<Airport> temp;
-            while (v->getParent() != nullptr) {
-                temp.push_back(v->getInfo());
-                v = v->getParent();
-            }
-            temp.push_back(initialAirport);
-            reverse(temp.begin() , temp.end());
-            res.push_back(temp);
-        }
-
-        for (const Edge<Airport> &e : v->getAdj()) {
-
-            if(airlines.find(e.getAirline()) != airlines.end())
-            {
-                Vertex<Airport>* w = e.getDest();
-                if (!w->isVisited()) {
-                    w->setParent(v);
-                    q.push(w);
-                    w->setVisited(true);
-                }
-            }
-        }
-    }
-
-    return res;
+                                                                 unordered_set<std::string> airlines) const{
+    return RouteTrips(AirportIds(csr, {initialAirport}), CountryAirports(attributes, country), 3, airlines);
 }
 /**
  * @brief Finds trips from airports in a city to the specified airport.
@@ -1573,60 +918,12 @@ list<vector<Airport>> Logic::AirportToCountryAirlineOnlyFilter(Airport initialAi
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
-Logic::CityToAirport(const Airport& destAirport , const std::string& city, const std::string& country, int choice, unordered_set<std::string> airlines) {
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == country && v->getInfo().getCity() == city)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirport(v->getInfo() , destAirport);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirportAirlineAvoidFilters(v->getInfo() , destAirport , airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirportAirlineOnlyFilters(v->getInfo() , destAirport , airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+Logic::CityToAirport(const Airport& destAirport , const std::string& city, const std::string& country, int choice, unordered_set<std::string> airlines) const {
+    return RouteTrips(CityAirports(attributes, city, country), AirportIds(csr, {destAirport}), choice, airlines);
 }
 /**
  * @brief Finds trips from airports in an initial city to airports in a final city.
@@ -1637,61 +934,13 @@ Logic::CityToAirport(const Airport& destAirport , const std::string& city, const
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
-Logic::CityToCity(const std::string& InitialCity, const std::string& InitialCountry,const std::string& FinalCity, const std::string& FinalCountry, int choice, const unordered_set<std::string>& airlines) {
-
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == InitialCountry && v->getInfo().getCity() == InitialCity)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCity(v->getInfo() , FinalCity , FinalCountry);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCityAirlineAvoidFilter(v->getInfo() , FinalCity , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCityAirlineOnlyFilter(v->getInfo() , FinalCity , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+Logic::CityToCity(const std::string& InitialCity, const std::string& InitialCountry,const std::string& FinalCity, const std::string& FinalCountry, int choice, const unordered_set<std::string>& airlines) const {
+    return RouteTrips(CityAirports(attributes, InitialCity, InitialCountry),
+                      CityAirports(attributes, FinalCity, FinalCountry), choice, airlines);
 }
 
 /**
@@ -1702,60 +951,12 @@ Logic::CityToCity(const std::string& InitialCity, const std::string& InitialCoun
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
-Logic::CityToCountry(const std::string& Initialcity, const std::string& InitialCountry, const std::string& FinalCountry, int choice, const unordered_set<string>& airlines) {
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == InitialCountry && v->getInfo().getCity() == Initialcity)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountry(v->getInfo() , FinalCountry);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountryAirlineAvoidFilter(v->getInfo() , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountryAirlineOnlyFilter(v->getInfo() , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+Logic::CityToCountry(const std::string& Initialcity, const std::string& InitialCountry, const std::string& FinalCountry, int choice, const unordered_set<string>& airlines) const {
+    return RouteTrips(CityAirports(attributes, Initialcity, InitialCountry), CountryAirports(attributes, FinalCountry), choice, airlines);
 }
 /**
  * @brief Finds trips from airports in a country to the specified airport.
@@ -1764,62 +965,13 @@ Logic::CityToCountry(const std::string& Initialcity, const std::string& InitialC
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
 Logic::CountryToAirport(const Airport &destAirport, const string &country, int choice,
-                        unordered_set<std::string> airlines) {
-
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == country)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirport(v->getInfo() , destAirport);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirportAirlineAvoidFilters(v->getInfo() , destAirport, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToAirportAirlineOnlyFilters(v->getInfo() , destAirport, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+                        unordered_set<std::string> airlines) const {
+    return RouteTrips(CountryAirports(attributes, country), AirportIds(csr, {destAirport}), choice, airlines);
 }
 /**
  * @brief Finds trips from airports in a country to airports in the specified city.
@@ -1829,62 +981,13 @@ Logic::CountryToAirport(const Airport &destAirport, const string &country, int c
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
 Logic::CountryToCity(const string &InitialCountry, const string &FinalCity,
-                     const string &FinalCountry, int choice, const unordered_set<std::string> &airlines) {
-
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == InitialCountry)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCity(v->getInfo() , FinalCity , FinalCountry);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCityAirlineAvoidFilter(v->getInfo() , FinalCity , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCityAirlineOnlyFilter(v->getInfo() , FinalCity , FinalCountry, airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+                     const string &FinalCountry, int choice, const unordered_set<std::string> &airlines) const {
+    return RouteTrips(CountryAirports(attributes, InitialCountry), CityAirports(attributes, FinalCity, FinalCountry), choice, airlines);
 }
 /**
  * @brief Finds trips from airports in a country to airports in another country.
@@ -1893,66 +996,17 @@ Logic::CountryToCity(const string &InitialCountry, const string &FinalCity,
  * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
  * @param airlines Set of airlines to avoid or include based on the choice.
  * @return A list of trips, each represented as a vector of airports.
- * @details Time complexity: O(I * (V + E)), where I is the number of initial airports, V is the number of vertices (airports),
- * and E is the number of edges (flights) in the graph.
+ * @details Time complexity: O(V + E), where V is the number of vertices (airports) and E is the number of edges (flights) in the graph.
+ * All initial airports are searched from at once.
  */
 list<vector<Airport>>
 Logic::CountryToCountry(const string &InitialCountry, const string &country, int choice,
-                        const unordered_set<std::string> &airlines) {
-
-    vector<Vertex<Airport>*> initialAirports;
-    for(auto v : graph.getVertexSet())
-    {
-        if(v->getInfo().getCountry() == InitialCountry)
-        {
-            initialAirports.push_back(v);
-        }
-    }
-
-    list<vector<Airport>> res;
-    list<vector<Airport>> temp;
-
-    switch (choice) {
-        case 1:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountry(v->getInfo() , country);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 2:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountryAirlineAvoidFilter(v->getInfo() , country , airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-        case 3:
-            for(auto v : initialAirports)
-            {
-                temp = AirportToCountryAirlineOnlyFilter(v->getInfo() , country , airlines);
-                for(const auto& smt : temp)
-                {
-                    res.push_back(smt);
-                }
-                temp.clear();
-            }
-            break;
-    }
-
-    return res;
+                        const unordered_set<std::string> &airlines) const {
+    return RouteTrips(CountryAirports(attributes, InitialCountry), CountryAirports(attributes, country), choice, airlines);
 }
 
 
-void Logic::NormaliseList(list<vector<Airport>>& list1) {
+void Logic::NormaliseList(list<vector<Airport>>& list1) const {
     int max_ = INT_MAX;
 
     for (const auto& it : list1) {
@@ -1962,3 +1016,105 @@ void Logic::NormaliseList(list<vector<Airport>>& list1) {
 
     list1.remove_if([max_](const auto& vec) { return vec.size() != max_; });
 }
+
+/**
+ * @brief Lists every trip with the fewest flights from a set of origin airports to a set of destination airports.
+ * @param origins The airports the trips may start from.
+ * @param destinations The airports the trips may end at.
+ * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
+ * @param airlines Set of airlines to avoid or include based on the choice.
+ * @param cap The greatest number of trips to list.
+ * @return A lazy iterator over the airport ids of each trip; it keeps the query context of its search, so it stays
+ * valid while other queries run, on this thread or any other.
+ * @details Time complexity: O(V + E) for the search, a bidirectional BFS between two single airports and a
+ * multi-source BFS otherwise. The trips themselves are walked as the iterator advances.
+ */
+CsrGraph::HopRouteIterator<AirlineRoutes> Logic::MinimumHopItineraries(const vector<Airport>& origins, const vector<Airport>& destinations,
+                                                                       int choice, const unordered_set<std::string>& airlines, size_t cap) const {
+    return HopRoutes(AirportIds(csr, origins), AirportIds(csr, destinations), AirlineRoutes{AirlineFilter(choice, airlines)},
+                     cap);
+}
+
+/**
+ * @brief Sets the greatest number of trips returned by the list-based route queries.
+ * @param cap The new cap.
+ * @details Time complexity: O(1)
+ */
+void Logic::setItineraryCap(size_t cap) {
+    itineraryCap = cap;
+}
+
+/**
+ * @brief Runs the route query engine for one choice of origins and destinations.
+ * @param origins Selector of the airports the trips may start from.
+ * @param destinations Selector of the airports the trips may end at.
+ * @param allowed Route predicate of the airline filter.
+ * @param cap The greatest number of trips to list.
+ * @return A lazy iterator over the airport ids of each trip; it keeps the query context of its search, so other
+ * queries do not affect it.
+ * @details The search and the iterator are compiled separately for each route predicate. Time complexity: O(V + E)
+ */
+template <class Origins, class Destinations, class RoutePredicate>
+CsrGraph::HopRouteIterator<RoutePredicate> Logic::HopRoutes(const Origins& origins, const Destinations& destinations,
+                                                            const RoutePredicate& allowed, size_t cap) const {
+    CsrGraph::ContextLease context;
+    csr.multiSourceBfs(origins, destinations, allowed, context->level);
+    return csr.minimumHopRoutes(allowed, std::move(context), cap);
+}
+
+/**
+ * @brief Runs the route query engine between two lists of airports.
+ * @details Same contract as the generic version, but between two single airports the search is a bidirectional BFS,
+ * which usually only visits the neighbourhoods of the two airports. Time complexity: O(V + E)
+ */
+template <class RoutePredicate>
+CsrGraph::HopRouteIterator<RoutePredicate> Logic::HopRoutes(const AirportIds& origins, const AirportIds& destinations,
+                                                            const RoutePredicate& allowed, size_t cap) const {
+    if (origins.size() == 1 && destinations.size() == 1) {
+        CsrGraph::ContextLease context;
+        csr.bidirectionalBfs(origins[0], destinations[0], allowed, context->hop);
+        return csr.bidirectionalRoutes(allowed, std::move(context), cap);
+    }
+    return HopRoutes<AirportIds, AirportIds, RoutePredicate>(origins, destinations, allowed, cap);
+}
+
+/**
+ * @brief Finds the trips with the fewest flights from a set of origin airports to a set of destination airports.
+ * @param origins Selector of the airports the trips may start from.
+ * @param destinations Selector of the airports the trips may end at.
+ * @param choice The choice of filter (1: No filter, 2: Airline Avoidance, 3: Airline Only).
+ * @param airlines Set of airlines to avoid or include based on the choice.
+ * @return Every trip with the minimum number of flights, up to the itinerary cap.
+ * @details The filter choice picks the route predicate here, once per query, so unfiltered queries run a search
+ * without any airline test. Time complexity: O(V + E + T * L), where T is the number of trips listed and L their
+ * length.
+ */
+template <class Origins, class Destinations>
+list<vector<Airport>> Logic::RouteTrips(const Origins& origins, const Destinations& destinations, int choice,
+                                        const unordered_set<std::string>& airlines) const {
+    if (choice == 2 || choice == 3) {
+        return TripList(HopRoutes(origins, destinations, AirlineRoutes{AirlineFilter(choice, airlines)}, itineraryCap));
+    }
+    return TripList(HopRoutes(origins, destinations, AnyRoute(), itineraryCap));
+}
+
+/**
+ * @brief Lists the trips of a route iterator as airports.
+ * @param routes The iterator.
+ * @return Every trip the iterator produces.
+ * @details Time complexity: O(T * L), where T is the number of trips and L their length.
+ */
+template <class RoutePredicate>
+list<vector<Airport>> Logic::TripList(CsrGraph::HopRouteIterator<RoutePredicate> routes) const {
+    list<vector<Airport>> res;
+    vector<int> route;
+    while (routes.next(route)) {
+        vector<Airport> trip;
+        trip.reserve(route.size());
+        for (int v : route) {
+            trip.push_back(csr.getAirport(v));
+        }
+        res.push_back(trip);
+    }
+    return res;
+}
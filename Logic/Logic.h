@@ -5,90 +5,197 @@
 #include <memory>
 #include "Graph.h"
 #include "Airport.h"
+#include "CsrGraph.h"
+#include "RouteQuery.h"
+#include "SpatialIndex.h"
+#include "AttributeIndex.h"
+#include "AirportStats.h"
+
+/**
+ * @struct Trip
+ * @brief A single route between two airports together with its length.
+ */
+struct Trip {
+    vector<Airport> airports;   ///< The airports of the route, from the origin to the destination; empty if none.
+    double kilometres = 0;      ///< Sum of the great-circle distances of the flights.
+    int flights = 0;            ///< Number of flights, airports.size() - 1 for a non-empty route.
+    int settled = 0;            ///< Number of airports the search settled before reaching the destination.
+};
+
+/**
+ * @class LongestTripList
+ * @brief The pairs of airports whose shortest trip takes a given number of flights, with itineraries built on request.
+ *
+ * Only the pairs are stored; itinerary() searches for one shortest trip each time it is called. The list reads the
+ * graph of the Logic that made it, so it must not outlive it.
+ */
+class LongestTripList {
+public:
+    /**
+     * @brief Wraps a list of pairs found in a graph.
+     * @param graph The graph the pairs were found in.
+     * @param pairs The (origin, destination) ids.
+     * @param flights The number of flights of the shortest trip of every pair.
+     * @details Time complexity: O(1)
+     */
+    LongestTripList(const CsrGraph& graph, std::vector<std::pair<int, int>> pairs, int flights)
+            : graph(&graph), pairs(std::move(pairs)), flights(flights) {}
+
+    /**
+     * @brief Gets the number of pairs.
+     * @details Time complexity: O(1)
+     */
+    size_t size() const { return pairs.size(); }
+
+    /**
+     * @brief Gets the number of flights of the shortest trip of every pair.
+     * @details Time complexity: O(1)
+     */
+    int getFlights() const { return flights; }
+
+    /**
+     * @brief Gets the origin of a pair.
+     * @param i The position of the pair, sorted by origin.
+     * @details Time complexity: O(1)
+     */
+    const Airport& origin(size_t i) const { return graph->getAirport(pairs[i].first); }
+
+    /**
+     * @brief Gets the destination of a pair.
+     * @param i The position of the pair, sorted by origin.
+     * @details Time complexity: O(1)
+     */
+    const Airport& destination(size_t i) const { return graph->getAirport(pairs[i].second); }
+
+    vector<Airport> itinerary(size_t i) const;
+
+private:
+    const CsrGraph* graph;
+    std::vector<std::pair<int, int>> pairs;
+    int flights;
+};
 
 /**
  * @class Logic
  * @brief Processes all the background logic of the program ranging from counting algorithm to filter functions
+ *
+ * The queries are const and keep their scratch state in a CsrGraph::QueryContext leased for the query, so one Logic
+ * can answer queries from many threads at once, and an iterator over trips stays valid while other queries run.
  */
 class Logic {
 private:
-    Graph<Airport> graph;
+    //contiguous form of the loaded graph, serving every query
+    CsrGraph csr;
+    //k-d tree over the airport coordinates, for the Location queries
+    SpatialIndex spatial;
+    //airports of each city and country and routes of each airline, for the City, Country and airline queries
+    AttributeIndex attributes;
+    //flight and destination counts of each airport, for the statistics queries
+    AirportStats stats;
     //maps Airport names to codes
     unordered_map<std::string , std::string> NamesToCodes;
     unordered_map<std::string , Airline> AirlinesCodes;
+    //greatest number of trips returned by the list-based route queries
+    size_t itineraryCap = 1000;
+    //greatest distance, in kilometres, from a location to the airports its queries may use; 0 keeps the closest only
+    double locationRadius = 0;
+
+    template <class Origins, class Destinations, class RoutePredicate>
+    CsrGraph::HopRouteIterator<RoutePredicate> HopRoutes(const Origins& origins, const Destinations& destinations, const RoutePredicate& allowed, size_t cap) const;
+    template <class RoutePredicate>
+    CsrGraph::HopRouteIterator<RoutePredicate> HopRoutes(const AirportIds& origins, const AirportIds& destinations, const RoutePredicate& allowed, size_t cap) const;
+    AirportIds LocationAirports(double latitude, double longitude) const;
+    template <class Origins, class Destinations>
+    list<vector<Airport>> RouteTrips(const Origins& origins, const Destinations& destinations, int choice , const unordered_set<std::string>& airlines) const;
+    template <class RoutePredicate>
+    list<vector<Airport>> TripList(CsrGraph::HopRouteIterator<RoutePredicate> routes) const;
 public:
     Logic();
-    Logic(Graph<Airport>& g);
+    Logic(const Graph<Airport>& g);
+    Logic(CsrGraph csr, AirportStats stats);
+    const CsrGraph& getCsrGraph() const;
+    const AirportStats& getAirportStats() const;
 
     void MapAirports();
-    unordered_map<std::string , std::string> getNamesToCodes();
-
-    int GlobalNumbers();
-    int GlobalNumberOfAirports();
-    int NumberOfFlightsPerCity(std::string city);
-    int NumberOfFlightsPerAirline(const std::string& airlineCode);
-    int NumberOfCountries(std::string airportCode);
-    int NumberOfCountriesThatCityFliesTo(std::string city);
-    vector<vector<Airport>> FindMaxTripBfs(const Airport &Airport, int k);
-    vector<string> GreatestKIndeegrees(int k);
-    size_t GlobalNumberOfFlights();
-
-    std::pair<int , int> FlightsOutOfAirportAndDifferentAirlines(const std::string& AirportCode);
-    std::pair<std::vector<std::pair<Airport, Airport>> , int> AirportAtMaximumDistance();
-
-    int NumberOfDestinationsForAirport(const string &airportCode);
-    int NumberOfDestinationsForCity(const string &airportCode);
-    int NumberOfDestinationsForCountry(const string &airportCode);
-
-    unordered_set<Airport> findArticulationPoints();
-
-    void dfs_articulationPoints(Vertex<Airport> *v, unordered_set<Airport> &articPoints, stack<Vertex<Airport> *> &s,int &index);
-
-    vector<Airport> shortestPath(const Airport& initialAirport , const Airport& destAirport);
-
-    list<vector<Airport>> AirportToAirport(const Airport& initialAirport, const Airport& destAirport);
-    list<vector<Airport>> AirportToAirportAirlineOnlyFilters(const Airport& initialAirport, const Airport& destAirport , unordered_set<std::string> airlines);
-    list<vector<Airport>> AirportToAirportAirlineAvoidFilters(const Airport& initialAirport, const Airport& destAirport , unordered_set<std::string> airlines);
-
-    list<vector<Airport>> AirportToCity(const Airport& initialAirport, const std::string& city , const std::string& country);
-    list<vector<Airport>> AirportToCityAirlineAvoidFilter(const Airport& initialAirport ,const std::string& city , const std::string& country,unordered_set<std::string> airlines);
-    list<vector<Airport>> AirportToCityAirlineOnlyFilter(const Airport& initialAirport ,const std::string& city , const std::string& country,unordered_set<std::string> airlines);
-
-    list<vector<Airport>> AirportToCountry(const Airport& initialAirport, const std::string& country);
-    list<vector<Airport>> AirportToCountryAirlineAvoidFilter(Airport initialAirport , std::string country,unordered_set<std::string> airlines);
-    list<vector<Airport>> AirportToCountryAirlineOnlyFilter(Airport initialAirport , std::string country,unordered_set<std::string> airlines);
-
-    list<vector<Airport>> CityToAirport(const Airport& destAirport , const std::string& city, const std::string& country , int choice , unordered_set<std::string> airlines);
-    list<vector<Airport>> CityToCity(const std::string& InitialCity, const std::string& InitialCountry,const std::string& FinalCity, const std::string& FinalCountry, int choice , const unordered_set<std::string>& airlines);
-    list<vector<Airport>> CityToCountry(const std::string& Initialcity, const std::string& InitialCountry, const std::string& country , int choice , const unordered_set<std::string>& airlines);
-
-    list<vector<Airport>> CountryToAirport(const Airport& destAirport , const std::string& country , int choice , unordered_set<std::string> airlines);
-    list<vector<Airport>> CountryToCity(const string &InitialCountry, const string &FinalCity,const string &FinalCountry, int choice, const unordered_set<std::string> &airlines);
-    list<vector<Airport>> CountryToCountry(const std::string& InitialCountry, const std::string& country , int choice , const unordered_set<std::string>& airlines);
-
-
-    list<vector<Airport>> LocationToAirport(double source_latitude, double source_longitude, Airport dest);
-    list<vector<Airport>> LocationToCity(double source_latitude, double source_longitude, const std::string city, const std::string& country);
-    list<vector<Airport>> LocationToCountry(double source_latitude, double source_longitude, const std::string country);
-    list<vector<Airport>> AirportToLocation(Airport source, double dest_latitude, double dest_longitude);
-    list<vector<Airport>> CityToLocation(const std::string city, const std::string country, double dest_latitude, double dest_longitude);
-
-    vector<Airport> FindClosestAirportsToLocation(double Latitude, double Longitude);
-
-    list<vector<Airport>> LocationToAirportAirlineOnlyFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines);
-    list<vector<Airport>> LocationToAirportAirlineAvoidFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines);
-    list<vector<Airport>> LocationToCityAirlineOnlyFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines);
-    list<vector<Airport>> LocationToCityAirlineAvoidFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines);
-    list<vector<Airport>> LocationToCountryAirlineOnlyFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines);
-    list<vector<Airport>> LocationToCountryAirlineAvoidFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines);
-    list<vector<Airport>> AirportToLocationAirlineOnlyFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline);
-    list<vector<Airport>> AirportToLocationAirlineAvoidFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline);
+    unordered_map<std::string , std::string> getNamesToCodes() const;
+
+    int GlobalNumbers() const;
+    int GlobalNumberOfAirports() const;
+    int NumberOfFlightsPerCity(std::string city) const;
+    int NumberOfFlightsPerAirline(const std::string& airlineCode) const;
+    int NumberOfCountries(std::string airportCode) const;
+    int NumberOfCountriesThatCityFliesTo(std::string city) const;
+    vector<vector<Airport>> FindMaxTripBfs(const Airport &Airport, int k) const;
+    vector<string> GreatestKIndeegrees(int k) const;
+    size_t GlobalNumberOfFlights() const;
+
+    std::pair<int , int> FlightsOutOfAirportAndDifferentAirlines(const std::string& AirportCode) const;
+    std::pair<std::vector<Trip>, int> AirportAtMaximumDistance() const;
+    LongestTripList LongestTrips(int diameter) const;
+
+    int NumberOfDestinationsForAirport(const string &airportCode) const;
+    int NumberOfDestinationsForCity(const string &airportCode) const;
+    int NumberOfDestinationsForCountry(const string &airportCode) const;
+
+    unordered_set<Airport> findArticulationPoints() const;
+    int calculateDiameter() const;
+
+    vector<Airport> shortestPath(const Airport& initialAirport , const Airport& destAirport) const;
+
+    list<vector<Airport>> AirportToAirport(const Airport& initialAirport, const Airport& destAirport) const;
+    list<vector<Airport>> AirportToAirportAirlineOnlyFilters(const Airport& initialAirport, const Airport& destAirport , unordered_set<std::string> airlines) const;
+    list<vector<Airport>> AirportToAirportAirlineAvoidFilters(const Airport& initialAirport, const Airport& destAirport , unordered_set<std::string> airlines) const;
+
+    list<vector<Airport>> AirportToCity(const Airport& initialAirport, const std::string& city , const std::string& country) const;
+    list<vector<Airport>> AirportToCityAirlineAvoidFilter(const Airport& initialAirport ,const std::string& city , const std::string& country,unordered_set<std::string> airlines) const;
+    list<vector<Airport>> AirportToCityAirlineOnlyFilter(const Airport& initialAirport ,const std::string& city , const std::string& country,unordered_set<std::string> airlines) const;
+
+    list<vector<Airport>> AirportToCountry(const Airport& initialAirport, const std::string& country) const;
+    list<vector<Airport>> AirportToCountryAirlineAvoidFilter(Airport initialAirport , std::string country,unordered_set<std::string> airlines) const;
+    list<vector<Airport>> AirportToCountryAirlineOnlyFilter(Airport initialAirport , std::string country,unordered_set<std::string> airlines) const;
+
+    list<vector<Airport>> CityToAirport(const Airport& destAirport , const std::string& city, const std::string& country , int choice , unordered_set<std::string> airlines) const;
+    list<vector<Airport>> CityToCity(const std::string& InitialCity, const std::string& InitialCountry,const std::string& FinalCity, const std::string& FinalCountry, int choice , const unordered_set<std::string>& airlines) const;
+    list<vector<Airport>> CityToCountry(const std::string& Initialcity, const std::string& InitialCountry, const std::string& country , int choice , const unordered_set<std::string>& airlines) const;
+
+    list<vector<Airport>> CountryToAirport(const Airport& destAirport , const std::string& country , int choice , unordered_set<std::string> airlines) const;
+    list<vector<Airport>> CountryToCity(const string &InitialCountry, const string &FinalCity,const string &FinalCountry, int choice, const unordered_set<std::string> &airlines) const;
+    list<vector<Airport>> CountryToCountry(const std::string& InitialCountry, const std::string& country , int choice , const unordered_set<std::string>& airlines) const;
+
+
+    list<vector<Airport>> LocationToAirport(double source_latitude, double source_longitude, Airport dest) const;
+    list<vector<Airport>> LocationToCity(double source_latitude, double source_longitude, const std::string city, const std::string& country) const;
+    list<vector<Airport>> LocationToCountry(double source_latitude, double source_longitude, const std::string country) const;
+    list<vector<Airport>> AirportToLocation(Airport source, double dest_latitude, double dest_longitude) const;
+    list<vector<Airport>> CityToLocation(const std::string city, const std::string country, double dest_latitude, double dest_longitude) const;
+
+    vector<Airport> FindClosestAirportsToLocation(double Latitude, double Longitude) const;
+    vector<Airport> AirportsNearLocation(double Latitude, double Longitude) const;
+    void setLocationRadius(double kilometres);
+    double getLocationRadius() const;
+    vector<Airport> AirportsInCity(const std::string& city, const std::string& country) const;
+    vector<Airport> AirportsInCountry(const std::string& country) const;
+    bool IsCity(const std::string& city) const;
+    bool IsAirport(const std::string& airportCode) const;
+
+    CsrGraph::HopRouteIterator<AirlineRoutes> MinimumHopItineraries(const vector<Airport>& origins, const vector<Airport>& destinations, int choice , const unordered_set<std::string>& airlines, size_t cap) const;
+    void setItineraryCap(size_t cap);
+    Trip ShortestDistanceTrip(const vector<Airport>& origins, const vector<Airport>& destinations, int choice , const unordered_set<std::string>& airlines, bool useAStar) const;
+
+    list<vector<Airport>> LocationToAirportAirlineOnlyFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> LocationToAirportAirlineAvoidFilters(double source_latitude, double source_longitude, Airport dest, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> LocationToCityAirlineOnlyFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> LocationToCityAirlineAvoidFilters(double source_latitude, double source_longitude, const std::string city, const std::string& country, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> LocationToCountryAirlineOnlyFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> LocationToCountryAirlineAvoidFilter(double source_latitude, double source_longitude, const std::string country, unordered_set<std::string> airlines) const;
+    list<vector<Airport>> AirportToLocationAirlineOnlyFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline) const;
+    list<vector<Airport>> AirportToLocationAirlineAvoidFilters(Airport source, double dest_latitude, double dest_longitude, unordered_set<std::string> airline) const;
 
     //Auxiliary functions
-    double HaversineAlgorithm(double lat1, double lon1,double lat2, double lon2);
-    vector<Airport> nodesAtDistanceBFS(const string &airportCode, int k);
-    vector<int> analyzeReachableAirports(const vector<Airport> &reachableAirports);
-    void NormaliseList(list<vector<Airport>>& list1);
+    double HaversineAlgorithm(double lat1, double lon1,double lat2, double lon2) const;
+    vector<Airport> nodesAtDistanceBFS(const string &airportCode, int k) const;
+    vector<int> analyzeReachableAirports(const vector<Airport> &reachableAirports) const;
+    void NormaliseList(list<vector<Airport>>& list1) const;
 };
 
 
@@ -0,0 +1,92 @@
+#include "MappedFile.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Default constructor, creates a closed file.
+ * @details Time complexity: O(1)
+ */
+MappedFile::MappedFile() : begin(nullptr), length(0), open(false), mapped(false) {}
+
+/**
+ * @brief Maps the file at the given path.
+ * @param path The path of the file.
+ * @details Time complexity: O(1) when mapped, O(n) when read into memory.
+ */
+MappedFile::MappedFile(const std::string& path) : MappedFile() {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) == 0) {
+        length = (size_t) info.st_size;
+        if (length == 0) {
+            open = true;
+        } else {
+            void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                begin = static_cast<const char*>(address);
+                open = true;
+                mapped = true;
+            }
+        }
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    begin = buffer.empty() ? nullptr : buffer.data();
+    length = buffer.size();
+    open = true;
+#endif
+}
+
+/**
+ * @brief Unmaps the file.
+ * @details Time complexity: O(1)
+ */
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+}
+
+/**
+ * @brief Checks if the file was opened successfully.
+ * @return True if the contents are available.
+ * @details Time complexity: O(1)
+ */
+bool MappedFile::isOpen() const {
+    return open;
+}
+
+/**
+ * @brief Gets the first byte of the file.
+ * @return A pointer to the contents, or nullptr for a closed or empty file.
+ * @details Time complexity: O(1)
+ */
+const char* MappedFile::data() const {
+    return begin;
+}
+
+/**
+ * @brief Gets the size of the file.
+ * @return The number of bytes.
+ * @details Time complexity: O(1)
+ */
+size_t MappedFile::size() const {
+    return length;
+}
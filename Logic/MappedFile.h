@@ -0,0 +1,68 @@
+#ifndef PROJETO_2_MAPPEDFILE_H
+#define PROJETO_2_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory-mapped where the platform allows it.
+ *
+ * On POSIX systems the file is mapped with mmap; elsewhere its contents are read into a buffer owned by the object.
+ * Either way data() stays valid until the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Default constructor, creates a closed file.
+     * @details Time complexity: O(1)
+     */
+    MappedFile();
+
+    /**
+     * @brief Maps the file at the given path.
+     * @param path The path of the file.
+     * @details Time complexity: O(1) when mapped, O(n) when read into memory.
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmaps the file.
+     * @details Time complexity: O(1)
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Checks if the file was opened successfully.
+     * @return True if the contents are available.
+     * @details Time complexity: O(1)
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Gets the first byte of the file.
+     * @return A pointer to the contents, or nullptr for a closed or empty file.
+     * @details Time complexity: O(1)
+     */
+    const char* data() const;
+
+    /**
+     * @brief Gets the size of the file.
+     * @return The number of bytes.
+     * @details Time complexity: O(1)
+     */
+    size_t size() const;
+
+private:
+    const char* begin;
+    size_t length;
+    bool open;
+    bool mapped;
+    std::vector<char> buffer;
+};
+
+#endif //PROJETO_2_MAPPEDFILE_H
@@ -0,0 +1,195 @@
+#ifndef PROJETO_2_ROUTEQUERY_H
+#define PROJETO_2_ROUTEQUERY_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "AirlineFilter.h"
+#include "AttributeIndex.h"
+#include "StringPool.h"
+
+/*
+ * Policies of the route query engine, CsrGraph::multiSourceBfs().
+ *
+ * An airport selector picks the origins or the destinations of a query. It provides
+ *     template <class Visit> void forEach(const CsrGraph& graph, Visit visit) const;  // calls visit(id) per airport
+ *     bool contains(const CsrGraph& graph, int id) const;
+ * and a route predicate provides
+ *     bool operator()(const CsrGraph& graph, int route) const;
+ * Both are passed as template arguments, so a new kind of origin, destination or filter is a new small struct here
+ * and never another copy of the search.
+ */
+
+/**
+ * @class AirportIds
+ * @brief Selects an explicit list of airports, such as a single airport or the ones around a location.
+ */
+class AirportIds {
+public:
+    /**
+     * @brief Selects the airports of a list, skipping those that are not in the graph.
+     * @param graph The graph searched.
+     * @param airports The airports.
+     * @details Time complexity: O(A log A), where A is the number of airports given.
+     */
+    AirportIds(const CsrGraph& graph, const std::vector<Airport>& airports) {
+        for (const Airport& airport : airports) {
+            int id = graph.findVertex(airport.getCode());
+            if (id != -1) {
+                ids.push_back(id);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    /**
+     * @brief Selects airports by id, such as the ones a SpatialIndex query returns.
+     * @param ids The airport ids.
+     * @details Time complexity: O(A log A), where A is the number of airports given.
+     */
+    explicit AirportIds(std::vector<int> ids) : ids(std::move(ids)) {
+        std::sort(this->ids.begin(), this->ids.end());
+        this->ids.erase(std::unique(this->ids.begin(), this->ids.end()), this->ids.end());
+    }
+
+    /**
+     * @brief Visits every selected airport.
+     * @details Time complexity: O(A)
+     */
+    template <class Visit>
+    void forEach(const CsrGraph&, Visit visit) const {
+        for (int id : ids) {
+            visit(id);
+        }
+    }
+
+    /**
+     * @brief Tells whether an airport is selected.
+     * @details Time complexity: O(log A)
+     */
+    bool contains(const CsrGraph&, int id) const {
+        return std::binary_search(ids.begin(), ids.end(), id);
+    }
+
+    /**
+     * @brief Gets the number of selected airports.
+     * @details Time complexity: O(1)
+     */
+    size_t size() const { return ids.size(); }
+
+    /**
+     * @brief Gets the id of a selected airport.
+     * @param i The position of the airport, sorted by id.
+     * @details Time complexity: O(1)
+     */
+    int operator[](size_t i) const { return ids[i]; }
+
+private:
+    std::vector<int> ids;
+};
+
+/**
+ * @class CityAirports
+ * @brief Selects the airports of a city.
+ */
+class CityAirports {
+public:
+    /**
+     * @brief Selects the airports of a city; an unknown city selects none.
+     * @param index The index of the graph searched.
+     * @param city The city.
+     * @param country The country of the city.
+     * @details Time complexity: O(1) on average.
+     */
+    CityAirports(const AttributeIndex& index, const std::string& city, const std::string& country)
+            : cityId(StringPool::cities().find(city)), countryId(StringPool::countries().find(country)),
+              airports(index.cityAirports(cityId)) {}
+
+    /**
+     * @brief Visits every airport of the city.
+     * @details Time complexity: O(C), where C is the number of airports of cities with that name.
+     */
+    template <class Visit>
+    void forEach(const CsrGraph& graph, Visit visit) const {
+        for (int v : airports) {
+            if (graph.getAirport(v).getCountryId() == countryId) {
+                visit(v);
+            }
+        }
+    }
+
+    /**
+     * @brief Tells whether an airport is in the city.
+     * @details Time complexity: O(1)
+     */
+    bool contains(const CsrGraph& graph, int id) const {
+        const Airport& airport = graph.getAirport(id);
+        return airport.getCityId() == cityId && airport.getCountryId() == countryId;
+    }
+
+private:
+    int cityId;
+    int countryId;
+    AttributeIndex::Range airports;
+};
+
+/**
+ * @class CountryAirports
+ * @brief Selects the airports of a country.
+ */
+class CountryAirports {
+public:
+    /**
+     * @brief Selects the airports of a country; an unknown country selects none.
+     * @param index The index of the graph searched.
+     * @param country The country.
+     * @details Time complexity: O(1) on average.
+     */
+    CountryAirports(const AttributeIndex& index, const std::string& country)
+            : countryId(StringPool::countries().find(country)), airports(index.countryAirports(countryId)) {}
+
+    /**
+     * @brief Visits every airport of the country.
+     * @details Time complexity: O(C), where C is the number of airports of the country.
+     */
+    template <class Visit>
+    void forEach(const CsrGraph&, Visit visit) const {
+        for (int v : airports) {
+            visit(v);
+        }
+    }
+
+    /**
+     * @brief Tells whether an airport is in the country.
+     * @details Time complexity: O(1)
+     */
+    bool contains(const CsrGraph& graph, int id) const {
+        return graph.getAirport(id).getCountryId() == countryId;
+    }
+
+private:
+    int countryId;
+    AttributeIndex::Range airports;
+};
+
+/**
+ * @struct AnyRoute
+ * @brief Lets every route be taken; the test folds away in the search.
+ */
+struct AnyRoute {
+    bool operator()(const CsrGraph&, int) const { return true; }
+};
+
+/**
+ * @struct AirlineRoutes
+ * @brief Lets a route be taken when any of its airlines passes an airline filter.
+ */
+struct AirlineRoutes {
+    AirlineFilter filter;   ///< The compiled filter.
+
+    bool operator()(const CsrGraph& graph, int route) const { return graph.edgeAllowed(route, filter); }
+};
+
+#endif //PROJETO_2_ROUTEQUERY_H
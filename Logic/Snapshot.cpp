@@ -0,0 +1,460 @@
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "StringPool.h"
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+
+const char Magic[8] = {'A', 'E', 'D', 'G', 'R', 'A', 'P', 'H'};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t payloadSize;
+    uint64_t checksum;
+    uint32_t numStrings;
+    uint32_t numAirports;
+    uint32_t numAirlines;
+    int32_t diameter;
+    uint64_t stringOffsetsAt;
+    uint64_t stringBytesAt;
+    uint64_t airportsAt;
+    uint64_t airlinesAt;
+    uint64_t numRoutes;
+    uint64_t numFlights;
+    uint32_t numAirlineIds;
+    uint32_t reserved;
+    uint64_t airlineIdsAt;
+    uint64_t routeOffsetsAt;
+    uint64_t routeDestinationsAt;
+    uint64_t routeWeightsAt;
+    uint64_t routeAirlineOffsetsAt;
+    uint64_t routeAirlinesAt;
+    uint64_t inOffsetsAt;
+    uint64_t inSourcesAt;
+    uint64_t inRoutesAt;
+    uint64_t unitVectorsAt;
+    uint64_t statsAt;
+};
+
+struct AirportRecord {
+    uint32_t code;
+    uint32_t name;
+    uint32_t city;
+    uint32_t country;
+    double latitude;
+    double longitude;
+};
+
+struct AirlineRecord {
+    uint32_t code;
+    uint32_t name;
+    uint32_t callSign;
+    uint32_t country;
+};
+
+// Number of columns of AirportStats, stored one after the other in a single section
+const int StatColumns = 6;
+
+static_assert(sizeof(Header) % 8 == 0, "snapshot sections must stay 8-byte aligned");
+static_assert(sizeof(int) == sizeof(int32_t), "CSR and statistics arrays are stored as 32-bit integers");
+
+/**
+ * @brief 64-bit FNV-1a hash of a byte range.
+ * @details Time complexity: O(n)
+ */
+uint64_t Checksum(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char) data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Collects distinct strings and hands out their ids.
+ */
+class StringTable {
+public:
+    uint32_t intern(const std::string& str) {
+        auto it = ids.find(str);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        auto id = (uint32_t) strings.size();
+        ids.emplace(str, id);
+        strings.push_back(str);
+        return id;
+    }
+
+    const std::vector<std::string>& getStrings() const { return strings; }
+
+private:
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string> strings;
+};
+
+/**
+ * @brief Appends a section to the payload, padded to 8 bytes, and returns its file offset.
+ */
+uint64_t AppendSection(std::vector<char>& file, const void* data, size_t size) {
+    while (file.size() % 8 != 0) {
+        file.push_back(0);
+    }
+    uint64_t at = file.size();
+    const char* bytes = static_cast<const char*>(data);
+    file.insert(file.end(), bytes, bytes + size);
+    return at;
+}
+
+/**
+ * @brief Appends the values of a column as a section and returns its file offset.
+ */
+template <class T>
+uint64_t AppendColumn(std::vector<char>& file, const Column<T>& column) {
+    return AppendSection(file, column.data(), column.size() * sizeof(T));
+}
+
+/**
+ * @brief Points a column at a section of a mapped file, keeping the file open while the column lives.
+ */
+template <class T>
+Column<T> MappedColumn(const std::shared_ptr<const MappedFile>& file, uint64_t at, uint64_t count) {
+    return Column<T>(reinterpret_cast<const T*>(file->data() + at), count, file);
+}
+
+/**
+ * @brief Checks that an array of n + 1 offsets starts at 0, never decreases and ends at total.
+ */
+bool ValidOffsets(const int32_t* offsets, uint64_t n, uint64_t total) {
+    if (offsets[0] != 0 || (uint64_t) offsets[n] != total) {
+        return false;
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that every value of an array lies in [0, limit).
+ */
+bool ValidIds(const int32_t* values, uint64_t count, uint64_t limit) {
+    for (uint64_t i = 0; i < count; i++) {
+        if (values[i] < 0 || (uint64_t) values[i] >= limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that a section of count elements lies inside the file and is suitably aligned.
+ */
+bool SectionFits(uint64_t at, uint64_t count, size_t elementSize, size_t fileSize) {
+    if (at % 8 != 0 || at > fileSize) {
+        return false;
+    }
+    return count <= (fileSize - at) / elementSize;
+}
+
+}
+
+/**
+ * @brief Writes a snapshot of the network.
+ * @param path The snapshot file path; the file is replaced atomically.
+ * @param airlines The loaded airlines.
+ * @param diameter The precomputed diameter of the graph.
+ * @param csr The CSR form of the graph.
+ * @param stats The statistics of the graph.
+ * @return True if the file was written.
+ * @details Time complexity: O(V + F + S), where F is the number of flights and S the total length of the distinct
+ * strings.
+ */
+bool Snapshot::Save(const std::string& path, const std::unordered_set<Airline>& airlines, int diameter,
+                    const CsrGraph& csr, const AirportStats& stats) {
+    StringTable table;
+    size_t n = csr.getNumVertex();
+
+    std::vector<AirportRecord> airportRecords;
+    airportRecords.reserve(n);
+    for (size_t v = 0; v < n; v++) {
+        const Airport& airport = csr.getAirport((int) v);
+        airportRecords.push_back({table.intern(airport.getCode()), table.intern(airport.getName()),
+                                  table.intern(airport.getCity()), table.intern(airport.getCountry()),
+                                  airport.getLatitude(), airport.getLongitude()});
+    }
+
+    std::vector<AirlineRecord> airlineRecords;
+    airlineRecords.reserve(airlines.size());
+    for (const Airline& airline : airlines) {
+        airlineRecords.push_back({table.intern(airline.getCode()), table.intern(airline.getName()),
+                                  table.intern(airline.getCallSign()), table.intern(airline.getCountry())});
+    }
+
+    // The CSR flights keep their StringPool ids; the code of every id up to the largest is stored to map them back
+    CsrGraph::Arrays arrays = csr.getArrays();
+    int numAirlineIds = 0;
+    for (int id : arrays.routeAirlines) {
+        numAirlineIds = std::max(numAirlineIds, id + 1);
+    }
+    std::vector<uint32_t> airlineIds;
+    airlineIds.reserve(numAirlineIds);
+    for (int id = 0; id < numAirlineIds; id++) {
+        airlineIds.push_back(table.intern(StringPool::airlineCodes().get(id)));
+    }
+
+    AirportStats::Columns columns = stats.getColumns();
+    std::vector<int32_t> statValues;
+    statValues.reserve(StatColumns * n);
+    for (const Column<int>* column : {&columns.flightsOut, &columns.airlines, &columns.destinations,
+                                      &columns.cities, &columns.countries, &columns.flightsIn}) {
+        statValues.insert(statValues.end(), column->begin(), column->end());
+    }
+
+    std::vector<double> unitVectors;
+    unitVectors.reserve(3 * n);
+    for (const Column<double>* column : {&arrays.unitX, &arrays.unitY, &arrays.unitZ}) {
+        unitVectors.insert(unitVectors.end(), column->begin(), column->end());
+    }
+
+    std::vector<uint32_t> stringOffsets;
+    std::string stringBytes;
+    stringOffsets.reserve(table.getStrings().size() + 1);
+    for (const std::string& str : table.getStrings()) {
+        stringOffsets.push_back((uint32_t) stringBytes.size());
+        stringBytes += str;
+    }
+    stringOffsets.push_back((uint32_t) stringBytes.size());
+
+    Header header {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.headerSize = sizeof(Header);
+    header.numStrings = (uint32_t) table.getStrings().size();
+    header.numAirports = (uint32_t) airportRecords.size();
+    header.numAirlines = (uint32_t) airlineRecords.size();
+    header.diameter = diameter;
+    header.numRoutes = arrays.destinations.size();
+    header.numFlights = arrays.routeAirlines.size();
+    header.numAirlineIds = (uint32_t) airlineIds.size();
+
+    std::vector<char> file(sizeof(Header), 0);
+    header.stringOffsetsAt = AppendSection(file, stringOffsets.data(), stringOffsets.size() * sizeof(uint32_t));
+    header.stringBytesAt = AppendSection(file, stringBytes.data(), stringBytes.size());
+    header.airportsAt = AppendSection(file, airportRecords.data(), airportRecords.size() * sizeof(AirportRecord));
+    header.airlinesAt = AppendSection(file, airlineRecords.data(), airlineRecords.size() * sizeof(AirlineRecord));
+    header.airlineIdsAt = AppendSection(file, airlineIds.data(), airlineIds.size() * sizeof(uint32_t));
+    header.routeOffsetsAt = AppendColumn(file, arrays.offsets);
+    header.routeDestinationsAt = AppendColumn(file, arrays.destinations);
+    header.routeWeightsAt = AppendColumn(file, arrays.weights);
+    header.routeAirlineOffsetsAt = AppendColumn(file, arrays.routeAirlineOffsets);
+    header.routeAirlinesAt = AppendColumn(file, arrays.routeAirlines);
+    header.inOffsetsAt = AppendColumn(file, arrays.inOffsets);
+    header.inSourcesAt = AppendColumn(file, arrays.inSources);
+    header.inRoutesAt = AppendColumn(file, arrays.inRoutes);
+    header.unitVectorsAt = AppendSection(file, unitVectors.data(), unitVectors.size() * sizeof(double));
+    header.statsAt = AppendSection(file, statValues.data(), statValues.size() * sizeof(int32_t));
+    header.payloadSize = file.size() - sizeof(Header);
+    header.checksum = Checksum(file.data() + sizeof(Header), header.payloadSize);
+    std::memcpy(file.data(), &header, sizeof(Header));
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(file.data(), (std::streamsize) file.size());
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    return !error;
+}
+
+/**
+ * @brief Rebuilds the network from a snapshot file.
+ * @param path The snapshot file path.
+ * @param airlines The set to fill with the stored airlines.
+ * @param diameter Receives the stored diameter.
+ * @param csr Receives the CSR form of the graph, reading its arrays from the mapped file.
+ * @param stats Receives the statistics of the graph, reading its columns from the mapped file.
+ * @return True on success; false if the file is missing, has another version or fails validation, in which case
+ *         the outputs are left untouched.
+ * @details Time complexity: O(V + F), where F is the number of flights, to validate the arrays.
+ */
+bool Snapshot::Load(const std::string& path, std::unordered_set<Airline>& airlines, int& diameter, CsrGraph& csr,
+                    AirportStats& stats) {
+    auto mapping = std::make_shared<const MappedFile>(path);
+    const MappedFile& file = *mapping;
+    if (!file.isOpen() || file.size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header header {};
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+        header.headerSize != sizeof(Header) || header.payloadSize != file.size() - sizeof(Header)) {
+        return false;
+    }
+    if (Checksum(file.data() + sizeof(Header), header.payloadSize) != header.checksum) {
+        return false;
+    }
+    if (!SectionFits(header.stringOffsetsAt, header.numStrings + 1ull, sizeof(uint32_t), file.size()) ||
+        !SectionFits(header.airportsAt, header.numAirports, sizeof(AirportRecord), file.size()) ||
+        !SectionFits(header.airlinesAt, header.numAirlines, sizeof(AirlineRecord), file.size())) {
+        return false;
+    }
+    uint64_t n = header.numAirports;
+    uint64_t routes = header.numRoutes;
+    uint64_t flights = header.numFlights;
+    if (!SectionFits(header.airlineIdsAt, header.numAirlineIds, sizeof(uint32_t), file.size()) ||
+        !SectionFits(header.routeOffsetsAt, n + 1, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.routeDestinationsAt, routes, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.routeWeightsAt, routes, sizeof(double), file.size()) ||
+        !SectionFits(header.routeAirlineOffsetsAt, routes + 1, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.routeAirlinesAt, flights, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.inOffsetsAt, n + 1, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.inSourcesAt, routes, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.inRoutesAt, routes, sizeof(int32_t), file.size()) ||
+        !SectionFits(header.unitVectorsAt, 3 * n, sizeof(double), file.size()) ||
+        !SectionFits(header.statsAt, StatColumns * n, sizeof(int32_t), file.size())) {
+        return false;
+    }
+
+    auto stringOffsets = reinterpret_cast<const uint32_t*>(file.data() + header.stringOffsetsAt);
+    auto airportRecords = reinterpret_cast<const AirportRecord*>(file.data() + header.airportsAt);
+    auto airlineRecords = reinterpret_cast<const AirlineRecord*>(file.data() + header.airlinesAt);
+    const char* stringBytes = file.data() + header.stringBytesAt;
+    auto airlineIdRecords = reinterpret_cast<const uint32_t*>(file.data() + header.airlineIdsAt);
+    auto at = [&file](uint64_t offset) { return reinterpret_cast<const int32_t*>(file.data() + offset); };
+
+    if (header.stringBytesAt > file.size() ||
+        stringOffsets[header.numStrings] > file.size() - header.stringBytesAt) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header.numStrings; i++) {
+        if (stringOffsets[i] > stringOffsets[i + 1]) {
+            return false;
+        }
+    }
+    auto text = [&](uint32_t id) {
+        return std::string(stringBytes + stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id]);
+    };
+    auto validString = [&header](uint32_t id) { return id < header.numStrings; };
+    for (uint32_t i = 0; i < header.numAirports; i++) {
+        const AirportRecord& r = airportRecords[i];
+        if (!validString(r.code) || !validString(r.name) || !validString(r.city) || !validString(r.country)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.numAirlines; i++) {
+        const AirlineRecord& r = airlineRecords[i];
+        if (!validString(r.code) || !validString(r.name) || !validString(r.callSign) || !validString(r.country)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.numAirlineIds; i++) {
+        if (!validString(airlineIdRecords[i])) {
+            return false;
+        }
+    }
+    if (!ValidOffsets(at(header.routeOffsetsAt), n, routes) ||
+        !ValidIds(at(header.routeDestinationsAt), routes, n) ||
+        !ValidOffsets(at(header.routeAirlineOffsetsAt), routes, flights) ||
+        !ValidIds(at(header.routeAirlinesAt), flights, header.numAirlineIds) ||
+        !ValidOffsets(at(header.inOffsetsAt), n, routes) ||
+        !ValidIds(at(header.inSourcesAt), routes, n) ||
+        !ValidIds(at(header.inRoutesAt), routes, routes)) {
+        return false;
+    }
+
+    // Airline ids are handed out in the order the codes are first interned, so in a fresh process the stored ids
+    // are kept and the flights are read in place; otherwise they are translated once
+    std::vector<int> airlineIds(header.numAirlineIds);
+    bool sameIds = true;
+    for (uint32_t i = 0; i < header.numAirlineIds; i++) {
+        const char* code = stringBytes + stringOffsets[airlineIdRecords[i]];
+        airlineIds[i] = StringPool::airlineCodes().intern(
+                std::string_view(code, stringOffsets[airlineIdRecords[i] + 1] - stringOffsets[airlineIdRecords[i]]));
+        sameIds = sameIds && airlineIds[i] == (int) i;
+    }
+
+    std::vector<Airport> airportList;
+    airportList.reserve(header.numAirports);
+    for (uint32_t i = 0; i < header.numAirports; i++) {
+        const AirportRecord& r = airportRecords[i];
+        airportList.emplace_back(text(r.code), text(r.name), text(r.city), text(r.country),
+                                 r.latitude, r.longitude);
+    }
+    for (uint32_t i = 0; i < header.numAirlines; i++) {
+        const AirlineRecord& r = airlineRecords[i];
+        airlines.insert(Airline(text(r.code), text(r.name), text(r.callSign), text(r.country)));
+    }
+    diameter = header.diameter;
+
+    CsrGraph::Arrays arrays;
+    arrays.offsets = MappedColumn<int>(mapping, header.routeOffsetsAt, n + 1);
+    arrays.destinations = MappedColumn<int>(mapping, header.routeDestinationsAt, routes);
+    arrays.weights = MappedColumn<double>(mapping, header.routeWeightsAt, routes);
+    arrays.routeAirlineOffsets = MappedColumn<int>(mapping, header.routeAirlineOffsetsAt, routes + 1);
+    if (sameIds) {
+        arrays.routeAirlines = MappedColumn<int>(mapping, header.routeAirlinesAt, flights);
+    } else {
+        const int32_t* stored = at(header.routeAirlinesAt);
+        std::vector<int> translated(flights);
+        for (uint64_t i = 0; i < flights; i++) {
+            translated[i] = airlineIds[stored[i]];
+        }
+        arrays.routeAirlines = Column<int>(std::move(translated));
+    }
+    arrays.inOffsets = MappedColumn<int>(mapping, header.inOffsetsAt, n + 1);
+    arrays.inSources = MappedColumn<int>(mapping, header.inSourcesAt, routes);
+    arrays.inRoutes = MappedColumn<int>(mapping, header.inRoutesAt, routes);
+    arrays.unitX = MappedColumn<double>(mapping, header.unitVectorsAt, n);
+    arrays.unitY = MappedColumn<double>(mapping, header.unitVectorsAt + n * sizeof(double), n);
+    arrays.unitZ = MappedColumn<double>(mapping, header.unitVectorsAt + 2 * n * sizeof(double), n);
+    csr = CsrGraph(std::move(airportList), std::move(arrays));
+
+    AirportStats::Columns columns;
+    Column<int>* statColumns[StatColumns] = {&columns.flightsOut, &columns.airlines, &columns.destinations,
+                                             &columns.cities, &columns.countries, &columns.flightsIn};
+    for (int c = 0; c < StatColumns; c++) {
+        *statColumns[c] = MappedColumn<int>(mapping, header.statsAt + c * n * sizeof(int32_t), n);
+    }
+    stats = AirportStats(std::move(columns));
+    return true;
+}
+
+/**
+ * @brief Checks if a snapshot exists and is at least as recent as all of its source files.
+ * @param path The snapshot file path.
+ * @param sources The source files; sources that do not exist are ignored.
+ * @return True if the snapshot can be used instead of the sources.
+ * @details Time complexity: O(n), where n is the number of sources.
+ */
+bool Snapshot::IsUpToDate(const std::string& path, const std::vector<std::string>& sources) {
+    std::error_code error;
+    auto snapshotTime = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    for (const std::string& source : sources) {
+        auto sourceTime = std::filesystem::last_write_time(source, error);
+        if (!error && sourceTime > snapshotTime) {
+            return false;
+        }
+    }
+    return true;
+}
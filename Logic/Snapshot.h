@@ -0,0 +1,68 @@
+#ifndef PROJETO_2_SNAPSHOT_H
+#define PROJETO_2_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "Airport.h"
+#include "Airline.h"
+#include "CsrGraph.h"
+#include "AirportStats.h"
+
+/**
+ * @class Snapshot
+ * @brief Versioned binary image of a fully loaded network.
+ *
+ * The file holds a header, a table of interned strings, the airports and airlines as string ids, every array of the
+ * CsrGraph (which carries the flights and their precomputed Haversine weights) and the columns of the AirportStats,
+ * and derived statistics such as the diameter. Every section is 8-byte aligned so it can be read in place from a
+ * memory-mapped file: the restored CsrGraph and AirportStats point straight at the mapping instead of being rebuilt,
+ * and no pointer-based Graph is built at all. The payload is protected by a 64-bit FNV-1a checksum stored in the
+ * header.
+ */
+class Snapshot {
+public:
+    /// Format version, bumped whenever the layout or the meaning of the stored data changes; files with another
+    /// version are ignored.
+    static const uint32_t Version = 3;
+
+    /**
+     * @brief Writes a snapshot of the network.
+     * @param path The snapshot file path; the file is replaced atomically.
+     * @param airlines The loaded airlines.
+     * @param diameter The precomputed diameter of the graph.
+     * @param csr The CSR form of the graph.
+     * @param stats The statistics of the graph.
+     * @return True if the file was written.
+     * @details Time complexity: O(V + F + S), where F is the number of flights and S the total length of the distinct
+     * strings.
+     */
+    static bool Save(const std::string& path, const std::unordered_set<Airline>& airlines, int diameter,
+                     const CsrGraph& csr, const AirportStats& stats);
+
+    /**
+     * @brief Rebuilds the network from a snapshot file.
+     * @param path The snapshot file path.
+     * @param airlines The set to fill with the stored airlines.
+     * @param diameter Receives the stored diameter.
+     * @param csr Receives the CSR form of the graph, reading its arrays from the mapped file.
+     * @param stats Receives the statistics of the graph, reading its columns from the mapped file.
+     * @return True on success; false if the file is missing, has another version or fails validation, in which case
+     *         the outputs are left untouched.
+     * @details Time complexity: O(V + F), where F is the number of flights, to validate the arrays.
+     */
+    static bool Load(const std::string& path, std::unordered_set<Airline>& airlines, int& diameter, CsrGraph& csr,
+                     AirportStats& stats);
+
+    /**
+     * @brief Checks if a snapshot exists and is at least as recent as all of its source files.
+     * @param path The snapshot file path.
+     * @param sources The source files; sources that do not exist are ignored.
+     * @return True if the snapshot can be used instead of the sources.
+     * @details Time complexity: O(n), where n is the number of sources.
+     */
+    static bool IsUpToDate(const std::string& path, const std::vector<std::string>& sources);
+};
+
+#endif //PROJETO_2_SNAPSHOT_H
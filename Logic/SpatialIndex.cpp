@@ -0,0 +1,252 @@
+#include "SpatialIndex.h"
+#include "Haversine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Relative slack on squared chord lengths, a few ulps more than the rounding of the unit vectors and of
+// Haversine::distance(), so that the chord bound never drops an airport the exact distance would keep
+static const double ChordSlack = 64 * std::numeric_limits<double>::epsilon();
+
+/**
+ * @brief Gets the squared straight-line distance between two points.
+ * @details Time complexity: O(1)
+ */
+static double squaredChord(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Widens a squared chord length by the rounding its computation may have lost.
+ * @details The error of a squared chord s between two unit vectors is about sqrt(s) ulps, which dominates near 0.
+ * Time complexity: O(1)
+ */
+static double widen(double bound) {
+    return bound + ChordSlack * (bound + std::sqrt(bound));
+}
+
+/**
+ * @brief Builds an empty index.
+ * @details Time complexity: O(1)
+ */
+SpatialIndex::SpatialIndex() = default;
+
+/**
+ * @brief Indexes every airport of a graph.
+ * @param graph The graph; the index copies its unit vectors, coordinates and ids but keeps no reference to it.
+ * @details Time complexity: O(V log V)
+ */
+SpatialIndex::SpatialIndex(const CsrGraph& graph) {
+    int n = graph.getNumVertex();
+    points.resize(n);
+    axes.resize(n);
+    latitudes.resize(n);
+    longitudes.resize(n);
+    for (int v = 0; v < n; v++) {
+        latitudes[v] = graph.getAirport(v).getLatitude();
+        longitudes[v] = graph.getAirport(v).getLongitude();
+        graph.unitVector(v, points[v].coords);
+        points[v].id = v;
+    }
+    build(0, points.size());
+}
+
+/**
+ * @brief Arranges a range of points into a subtree, split on the axis along which they spread the most.
+ * @param lo The first point of the range.
+ * @param hi One past the last point of the range.
+ * @details Time complexity: O(N log N), where N = hi - lo.
+ */
+void SpatialIndex::build(size_t lo, size_t hi) {
+    if (lo >= hi) {
+        return;
+    }
+    double low[3], high[3];
+    for (int a = 0; a < 3; a++) {
+        low[a] = std::numeric_limits<double>::max();
+        high[a] = std::numeric_limits<double>::lowest();
+    }
+    for (size_t i = lo; i < hi; i++) {
+        for (int a = 0; a < 3; a++) {
+            low[a] = std::min(low[a], points[i].coords[a]);
+            high[a] = std::max(high[a], points[i].coords[a]);
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis]) {
+            axis = a;
+        }
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+                     [axis](const Point& p, const Point& q) { return p.coords[axis] < q.coords[axis]; });
+    axes[mid] = (unsigned char) axis;
+    build(lo, mid);
+    build(mid + 1, hi);
+}
+
+/**
+ * @brief Keeps the k smallest squared chord lengths from a query point to the points of a subtree.
+ * @param query The query point.
+ * @param lo The first point of the subtree.
+ * @param hi One past the last point of the subtree.
+ * @param k The number of lengths to keep.
+ * @param heap Max-heap of the k smallest lengths found so far.
+ * @details Time complexity: O(k log V) on average for the whole tree.
+ */
+void SpatialIndex::nearestChords(const double query[3], size_t lo, size_t hi, size_t k, std::vector<double>& heap) const {
+    if (lo >= hi) {
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    const Point& node = points[mid];
+    double d = squaredChord(query, node.coords);
+    if (heap.size() < k) {
+        heap.push_back(d);
+        std::push_heap(heap.begin(), heap.end());
+    } else if (d < heap.front()) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = d;
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    double diff = query[axes[mid]] - node.coords[axes[mid]];
+    bool leftFirst = diff < 0;
+    nearestChords(query, leftFirst ? lo : mid + 1, leftFirst ? mid : hi, k, heap);
+    if (heap.size() < k || diff * diff <= heap.front()) {
+        nearestChords(query, leftFirst ? mid + 1 : lo, leftFirst ? hi : mid, k, heap);
+    }
+}
+
+/**
+ * @brief Lists the points of a subtree within a squared chord length of a query point.
+ * @param query The query point.
+ * @param bound The greatest squared chord length, inclusive.
+ * @param lo The first point of the subtree.
+ * @param hi One past the last point of the subtree.
+ * @param found Output, the (squared chord length, id) of the points in range are appended to it.
+ * @details Time complexity: O(log V + R) on average for the whole tree, where R is the number of points in range.
+ */
+void SpatialIndex::collect(const double query[3], double bound, size_t lo, size_t hi,
+                           std::vector<std::pair<double, int>>& found) const {
+    if (lo >= hi) {
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    const Point& node = points[mid];
+    double d = squaredChord(query, node.coords);
+    if (d <= bound) {
+        found.emplace_back(d, node.id);
+    }
+
+    double diff = query[axes[mid]] - node.coords[axes[mid]];
+    if (diff <= 0 || diff * diff <= bound) {
+        collect(query, bound, lo, mid, found);
+    }
+    if (diff >= 0 || diff * diff <= bound) {
+        collect(query, bound, mid + 1, hi, found);
+    }
+}
+
+/**
+ * @brief Lists the airports within a squared chord length of a location with their Haversine distances.
+ * @param query The unit vector of the location.
+ * @param latitude The latitude of the location.
+ * @param longitude The longitude of the location.
+ * @param bound The greatest squared chord length; it is widened here.
+ * @return (Haversine distance, id) of every airport in range.
+ * @details Time complexity: O(log V + R) on average, where R is the number of airports in range.
+ */
+std::vector<std::pair<double, int>> SpatialIndex::exactWithin(const double query[3], double latitude, double longitude,
+                                                              double bound) const {
+    std::vector<std::pair<double, int>> found;
+    collect(query, widen(bound), 0, points.size(), found);
+    for (auto& candidate : found) {
+        int id = candidate.second;
+        candidate.first = Haversine::distance(latitude, longitude, latitudes[id], longitudes[id]);
+    }
+    return found;
+}
+
+/**
+ * @brief Finds the airports closest to a location.
+ * @param latitude The latitude of the location.
+ * @param longitude The longitude of the location.
+ * @return The ids of every airport at the smallest Haversine distance, sorted by id.
+ * @details Time complexity: O(log V) on average.
+ */
+std::vector<int> SpatialIndex::nearest(double latitude, double longitude) const {
+    std::vector<int> res;
+    if (points.empty()) {
+        return res;
+    }
+    double query[3];
+    Haversine::unitVector(latitude, longitude, query);
+    std::vector<double> heap;
+    nearestChords(query, 0, points.size(), 1, heap);
+
+    std::vector<std::pair<double, int>> candidates = exactWithin(query, latitude, longitude, heap.front());
+    double best = std::min_element(candidates.begin(), candidates.end())->first;
+    for (const auto& candidate : candidates) {
+        if (candidate.first == best) {
+            res.push_back(candidate.second);
+        }
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * @brief Finds the k airports closest to a location.
+ * @param latitude The latitude of the location.
+ * @param longitude The longitude of the location.
+ * @param k The number of airports.
+ * @return The ids of the k closest airports, sorted by Haversine distance and then by id.
+ * @details Time complexity: O(k log V) on average.
+ */
+std::vector<int> SpatialIndex::kNearest(double latitude, double longitude, size_t k) const {
+    std::vector<int> res;
+    if (points.empty() || k == 0) {
+        return res;
+    }
+    double query[3];
+    Haversine::unitVector(latitude, longitude, query);
+    std::vector<double> heap;
+    nearestChords(query, 0, points.size(), k, heap);
+
+    std::vector<std::pair<double, int>> candidates = exactWithin(query, latitude, longitude, heap.front());
+    std::sort(candidates.begin(), candidates.end());
+    for (size_t i = 0; i < candidates.size() && i < k; i++) {
+        res.push_back(candidates[i].second);
+    }
+    return res;
+}
+
+/**
+ * @brief Finds the airports within a distance of a location.
+ * @param latitude The latitude of the location.
+ * @param longitude The longitude of the location.
+ * @param kilometres The greatest Haversine distance, inclusive.
+ * @return The ids of the airports in range, sorted by id.
+ * @details Time complexity: O(log V + R) on average, where R is the number of airports in range.
+ */
+std::vector<int> SpatialIndex::withinRadius(double latitude, double longitude, double kilometres) const {
+    std::vector<int> res;
+    if (points.empty() || kilometres < 0) {
+        return res;
+    }
+    double query[3];
+    Haversine::unitVector(latitude, longitude, query);
+    for (const auto& candidate : exactWithin(query, latitude, longitude, Haversine::toSquaredChord(kilometres))) {
+        if (candidate.first <= kilometres) {
+            res.push_back(candidate.second);
+        }
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
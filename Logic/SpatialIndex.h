@@ -0,0 +1,80 @@
+#ifndef PROJETO_2_SPATIALINDEX_H
+#define PROJETO_2_SPATIALINDEX_H
+
+#include <cstddef>
+#include <vector>
+#include "CsrGraph.h"
+
+/**
+ * @class SpatialIndex
+ * @brief A k-d tree over the airports of a CsrGraph, placed on the unit sphere.
+ *
+ * Every airport is stored as the 3-D unit vector the graph keeps for it, so the straight-line (chord) distance
+ * between two vectors grows with the great-circle distance and a plain k-d tree can prune by it without trigonometry.
+ * The chord bound is widened by a few ulps, and only the candidates it keeps are measured with Haversine::distance(),
+ * so every result, ties included, is the one a scan of all the airports with Haversine::distance() would give.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @brief Builds an empty index.
+     * @details Time complexity: O(1)
+     */
+    SpatialIndex();
+
+    /**
+     * @brief Indexes every airport of a graph.
+     * @param graph The graph; the index copies its unit vectors, coordinates and ids but keeps no reference to it.
+     * @details Time complexity: O(V log V)
+     */
+    explicit SpatialIndex(const CsrGraph& graph);
+
+    /**
+     * @brief Finds the airports closest to a location.
+     * @param latitude The latitude of the location.
+     * @param longitude The longitude of the location.
+     * @return The ids of every airport at the smallest Haversine distance, sorted by id.
+     * @details Time complexity: O(log V) on average.
+     */
+    std::vector<int> nearest(double latitude, double longitude) const;
+
+    /**
+     * @brief Finds the k airports closest to a location.
+     * @param latitude The latitude of the location.
+     * @param longitude The longitude of the location.
+     * @param k The number of airports.
+     * @return The ids of the k closest airports, sorted by Haversine distance and then by id.
+     * @details Time complexity: O(k log V) on average.
+     */
+    std::vector<int> kNearest(double latitude, double longitude, size_t k) const;
+
+    /**
+     * @brief Finds the airports within a distance of a location.
+     * @param latitude The latitude of the location.
+     * @param longitude The longitude of the location.
+     * @param kilometres The greatest Haversine distance, inclusive.
+     * @return The ids of the airports in range, sorted by id.
+     * @details Time complexity: O(log V + R) on average, where R is the number of airports in range.
+     */
+    std::vector<int> withinRadius(double latitude, double longitude, double kilometres) const;
+
+private:
+    struct Point {
+        double coords[3];   ///< Unit vector of the airport.
+        int id;             ///< Airport id in the graph.
+    };
+
+    std::vector<Point> points;          ///< The tree; the node of a range [lo, hi) is at its middle.
+    std::vector<unsigned char> axes;    ///< Axis split at each node.
+    std::vector<double> latitudes;      ///< Latitude of each airport, by id.
+    std::vector<double> longitudes;     ///< Longitude of each airport, by id.
+
+    void build(size_t lo, size_t hi);
+    void nearestChords(const double query[3], size_t lo, size_t hi, size_t k, std::vector<double>& heap) const;
+    void collect(const double query[3], double bound, size_t lo, size_t hi,
+                 std::vector<std::pair<double, int>>& found) const;
+    std::vector<std::pair<double, int>> exactWithin(const double query[3], double latitude, double longitude,
+                                                    double bound) const;
+};
+
+#endif //PROJETO_2_SPATIALINDEX_H
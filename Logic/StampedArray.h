@@ -0,0 +1,84 @@
+#ifndef PROJETO_2_STAMPEDARRAY_H
+#define PROJETO_2_STAMPEDARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class StampedArray
+ * @brief Per-airport scratch array that is cleared in constant time between searches.
+ *
+ * Every slot keeps the epoch it was last written in, and a slot holds a value only while its stamp equals the
+ * current epoch; any other slot reads as the unset value. reset() starts a new epoch instead of rewriting the array,
+ * so a search that only touches a few airports costs time proportional to those airports and not to the whole graph.
+ * @tparam T The type of the values.
+ */
+template <class T>
+class StampedArray {
+public:
+    /**
+     * @brief Builds an empty array.
+     * @param unset The value read from slots not written since the last reset().
+     * @details Time complexity: O(1)
+     */
+    explicit StampedArray(T unset) : unset(unset), epoch(0) {}
+
+    /**
+     * @brief Clears every slot, resizing the array when the graph has another size.
+     * @param size The number of slots.
+     * @details Time complexity: O(1), except when the size changes or, once every 2^32 resets, the epoch wraps.
+     */
+    void reset(size_t size) {
+        if (size != slots.size()) {
+            slots.assign(size, {unset, 0});
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            for (Slot& slot : slots) {
+                slot.stamp = 0;
+            }
+            epoch = 1;
+        }
+    }
+
+    /**
+     * @brief Reads a slot.
+     * @param i The slot.
+     * @return The value written since the last reset(), or the unset value.
+     * @details Time complexity: O(1)
+     */
+    T operator[](size_t i) const { return slots[i].stamp == epoch ? slots[i].value : unset; }
+
+    /**
+     * @brief Tells whether a slot was written since the last reset().
+     * @param i The slot.
+     * @details Time complexity: O(1)
+     */
+    bool contains(size_t i) const { return slots[i].stamp == epoch; }
+
+    /**
+     * @brief Writes a slot.
+     * @param i The slot.
+     * @param value The value.
+     * @details Time complexity: O(1)
+     */
+    void set(size_t i, T value) {
+        slots[i].value = value;
+        slots[i].stamp = epoch;
+    }
+
+    size_t size() const { return slots.size(); }
+
+private:
+    // The value and its stamp share a cache line, so a probe costs one memory access
+    struct Slot {
+        T value;
+        unsigned stamp;
+    };
+
+    std::vector<Slot> slots;
+    T unset;
+    unsigned epoch;
+};
+
+#endif //PROJETO_2_STAMPEDARRAY_H
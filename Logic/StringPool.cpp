@@ -0,0 +1,101 @@
+#include "StringPool.h"
+#include <mutex>
+#include <stdexcept>
+
+/**
+ * @brief Creates an empty pool.
+ * @details Time complexity: O(1)
+ */
+StringPool::StringPool() : blocks(new std::unique_ptr<std::string[]>[MaxBlocks]), count(0) {}
+
+/**
+ * @brief Gets the id of a string, adding it to the pool if needed.
+ * @param str The string.
+ * @return The id of the string.
+ * @details Time complexity: O(l) on average, where l is the length of the string.
+ */
+int StringPool::intern(std::string_view str) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(str);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(str);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    if (count == BlockSize * MaxBlocks) {
+        throw std::length_error("StringPool is full");
+    }
+    if (count % BlockSize == 0) {
+        blocks[count / BlockSize].reset(new std::string[BlockSize]);
+    }
+    std::string& stored = blocks[count / BlockSize][count % BlockSize];
+    stored = str;
+    ids.emplace(stored, count);
+    return count++;
+}
+
+/**
+ * @brief Gets the id of a string without adding it.
+ * @param str The string.
+ * @return The id of the string, or NotFound.
+ * @details Time complexity: O(l) on average, where l is the length of the string.
+ */
+int StringPool::find(std::string_view str) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(str);
+    if (it == ids.end()) {
+        return NotFound;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Gets the string stored under an id.
+ * @param id An id returned by intern().
+ * @return The string.
+ * @details Time complexity: O(1)
+ */
+const std::string& StringPool::get(int id) const {
+    return blocks[id / BlockSize][id % BlockSize];
+}
+
+/**
+ * @brief Gets the number of strings in the pool.
+ * @return The number of ids handed out so far.
+ * @details Time complexity: O(1)
+ */
+int StringPool::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return count;
+}
+
+StringPool& StringPool::airportCodes() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::airportNames() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::cities() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::countries() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::airlineCodes() {
+    static StringPool pool;
+    return pool;
+}
@@ -0,0 +1,84 @@
+#ifndef PROJETO_2_STRINGPOOL_H
+#define PROJETO_2_STRINGPOOL_H
+
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class StringPool
+ * @brief Interns strings, giving each distinct string a dense integer id starting at 0.
+ *
+ * Equal strings always get the same id, so they can be compared and hashed as integers. A string never moves once
+ * interned, so the references returned by get() stay valid for the lifetime of the program. intern() and find() may
+ * be called from several threads; get() does not lock.
+ */
+class StringPool {
+public:
+    /// Id returned by find() for strings that were never interned.
+    static const int NotFound = -1;
+
+    /**
+     * @brief Creates an empty pool.
+     * @details Time complexity: O(1)
+     */
+    StringPool();
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /**
+     * @brief Gets the id of a string, adding it to the pool if needed.
+     * @param str The string.
+     * @return The id of the string.
+     * @details Time complexity: O(l) on average, where l is the length of the string.
+     */
+    int intern(std::string_view str);
+
+    /**
+     * @brief Gets the id of a string without adding it.
+     * @param str The string.
+     * @return The id of the string, or NotFound.
+     * @details Time complexity: O(l) on average, where l is the length of the string.
+     */
+    int find(std::string_view str) const;
+
+    /**
+     * @brief Gets the string stored under an id.
+     * @param id An id returned by intern().
+     * @return The string.
+     * @details Time complexity: O(1)
+     */
+    const std::string& get(int id) const;
+
+    /**
+     * @brief Gets the number of strings in the pool.
+     * @return The number of ids handed out so far.
+     * @details Time complexity: O(1)
+     */
+    int size() const;
+
+    /// Pool of airport codes.
+    static StringPool& airportCodes();
+    /// Pool of airport names.
+    static StringPool& airportNames();
+    /// Pool of city names.
+    static StringPool& cities();
+    /// Pool of country names.
+    static StringPool& countries();
+    /// Pool of airline codes.
+    static StringPool& airlineCodes();
+
+private:
+    static const int BlockSize = 4096;
+    static const int MaxBlocks = 4096;
+
+    std::unique_ptr<std::unique_ptr<std::string[]>[]> blocks;
+    std::unordered_map<std::string_view, int> ids;
+    int count;
+    mutable std::shared_mutex mutex;
+};
+
+#endif //PROJETO_2_STRINGPOOL_H
@@ -0,0 +1,130 @@
+#include "ThreadPool.h"
+
+// The pool whose tasks the current thread is running, if any
+static thread_local const ThreadPool* runningPool = nullptr;
+
+/**
+ * @brief Starts the worker threads.
+ * @param numThreads The total number of threads, counting the caller of parallelFor; 0 uses one per hardware thread.
+ * @details Time complexity: O(t), where t is the number of threads.
+ */
+ThreadPool::ThreadPool(unsigned numThreads) : stopping(false) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 1; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @brief Stops and joins the worker threads.
+ * @details Time complexity: O(t), where t is the number of threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Gets the number of threads that run tasks, counting the caller of parallelFor.
+ * @return The number of threads.
+ * @details Time complexity: O(1)
+ */
+unsigned ThreadPool::size() const {
+    return (unsigned) workers.size() + 1;
+}
+
+/**
+ * @brief Runs task(i) for every i in [0, count) and waits for all of them.
+ * @param count The number of tasks.
+ * @param task The task, called concurrently from several threads.
+ * @details Time complexity: O(count / t) task runs per thread.
+ */
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    if (workers.empty() || count == 1 || runningPool == this) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    auto call = std::make_shared<Call>();
+    call->task = &task;
+    call->count = count;
+    call->next = 0;
+    call->unfinished = count;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls.push_back(call);
+    }
+    wake.notify_all();
+
+    const ThreadPool* outer = runningPool;
+    runningPool = this;
+    runTasks(*call);
+    runningPool = outer;
+    retire(call);
+
+    std::unique_lock<std::mutex> lock(call->mutex);
+    call->done.wait(lock, [&call] { return call->unfinished == 0; });
+}
+
+/**
+ * @brief Gets the pool shared by the loaders and the analyses.
+ * @return The shared pool, with one thread per hardware thread.
+ * @details Time complexity: O(1)
+ */
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Body of every worker thread: waits for a queued parallelFor call, helps with its tasks and drops it once every
+// index is claimed
+void ThreadPool::workerLoop() {
+    runningPool = this;
+    while (true) {
+        std::shared_ptr<Call> call;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !calls.empty(); });
+            if (stopping) {
+                return;
+            }
+            call = calls.front();
+        }
+        runTasks(*call);
+        retire(call);
+    }
+}
+
+// Claims and runs task indices of a call until none are left, waking its caller after the last one
+void ThreadPool::runTasks(Call& call) {
+    size_t i;
+    while ((i = call.next.fetch_add(1)) < call.count) {
+        (*call.task)(i);
+        if (--call.unfinished == 0) {
+            std::lock_guard<std::mutex> lock(call.mutex);
+            call.done.notify_all();
+        }
+    }
+}
+
+// Removes a call whose indices are all claimed from the queue, if no other thread has yet
+void ThreadPool::retire(const std::shared_ptr<Call>& call) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find(calls.begin(), calls.end(), call);
+    if (it != calls.end()) {
+        calls.erase(it);
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef PROJETO_2_THREADPOOL_H
+#define PROJETO_2_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that run indexed tasks in parallel.
+ *
+ * parallelFor hands the indices 0..count-1 out one at a time to the workers and to the calling thread, and returns
+ * once all of them are done. Several threads may call it at once: their calls are queued and the workers help with
+ * them in order. A task that calls parallelFor on the same pool runs the nested call inline on its own thread.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param numThreads The total number of threads, counting the caller of parallelFor; 0 uses one per hardware
+     *        thread.
+     * @details Time complexity: O(t), where t is the number of threads.
+     */
+    explicit ThreadPool(unsigned numThreads = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Stops and joins the worker threads.
+     * @details Time complexity: O(t), where t is the number of threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Gets the number of threads that run tasks, counting the caller of parallelFor.
+     * @return The number of threads.
+     * @details Time complexity: O(1)
+     */
+    unsigned size() const;
+
+    /**
+     * @brief Runs task(i) for every i in [0, count) and waits for all of them.
+     * @param count The number of tasks.
+     * @param task The task, called concurrently from several threads.
+     * @details Time complexity: O(count / t) task runs per thread.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief Gets the pool shared by the loaders and the analyses.
+     * @return The shared pool, with one thread per hardware thread.
+     * @details Time complexity: O(1)
+     */
+    static ThreadPool& getShared();
+
+private:
+    /**
+     * @struct Call
+     * @brief The state of one parallelFor call, shared by the threads that help with it.
+     */
+    struct Call {
+        const std::function<void(size_t)>* task;   ///< The task of the call.
+        size_t count;                               ///< The number of task indices.
+        std::atomic<size_t> next;                   ///< The next index to claim.
+        std::atomic<size_t> unfinished;             ///< The number of indices not run yet.
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Call>> calls;    ///< Calls with indices left to claim, oldest first.
+    bool stopping;
+
+    void workerLoop();
+    void runTasks(Call& call);
+    void retire(const std::shared_ptr<Call>& call);
+};
+
+#endif //PROJETO_2_THREADPOOL_H
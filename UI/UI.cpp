@@ -42,32 +42,27 @@ void UI::loading_stuff(UI &ui) {
                  "“I do not need much now, just a place where I can rest. I am weary after these long years”, the man replied with a sigh.\n"
                  "“Good then! Old tree roots can serve as excellent resting places. Come, sit down with me and relax”.\n"
                  "The man sat down comfortably. This made the tree really glad and it smiled with tears of joy.\n";
-    LoadingFunctions::LoadFlights(g);
-    this->logic = Logic(g);
-    ui.load_sets();
+    CsrGraph csr;
+    AirportStats stats;
+    if(LoadingFunctions::LoadSnapshot(diameter, csr, stats)){
+        this->logic = Logic(std::move(csr), std::move(stats));
+    }
+    else{
+        Graph<Airport> g;
+        LoadingFunctions::LoadFlights(g);
+        this->logic = Logic(g);
+        diameter = logic.calculateDiameter();
+        LoadingFunctions::SaveSnapshot(diameter, logic.getCsrGraph(), logic.getAirportStats());
+    }
     for(auto airline : LoadingFunctions::getAirlines()){
         airlines.insert(airline.getCode());
     }
-    diameter = g.calculateDiameter();
     cout << "Load Finished" << endl;
     cout << "Press A to start the program: ";
     char op;
     validate_input(op,'A','A');
 }
 
-/**
- * @brief This function iterates over the vertices in the graph and populates sets of cities, airport codes,
- * and countries based on the information stored in each airport. The unordered sets are member variables of the UI class,
- * allowing efficient retrieval of unique values for further use in the user interface.
- */
-void UI::load_sets(){
-    for(auto airport: g.getVertexSet()){
-        this->cities.insert(airport->getInfo().getCity());
-        this->airport_codes.insert(airport->getInfo().getCode());
-        this->countries.insert(airport->getInfo().getCountry());
-    }
-}
-
 /**
  * @brief Clears the console screen by printing empty lines.
  */
@@ -156,10 +151,12 @@ void UI::main_menu(){
     cout << "A. Consult Flights" << endl
          << "B. Consult Flight Statistics" << endl
          << "C. Plan a Trip" << endl
-         << "D. Exit the Application" << endl
+         << "D. Plan the Shortest Trip in Kilometres" << endl
+         << "E. Set the Search Radius around Coordinates" << endl
+         << "F. Exit the Application" << endl
          << "Insert your choice:";
 
-    validate_input(op, 'A', 'D');
+    validate_input(op, 'A', 'F');
     switch(op){
         case 'A':
             flight_consultation();
@@ -170,6 +167,12 @@ void UI::main_menu(){
             trip_planner();
             break;
         case 'D':
+            shortest_trip_planner();
+            break;
+        case 'E':
+            location_radius();
+            break;
+        case 'F':
             cout << "Thanks for using our management system app!" << endl << "\n"
                  << "Made by: " << endl
                  << "Ângelo Oliveira || 202207798" << endl
@@ -182,6 +185,34 @@ void UI::main_menu(){
     }
 }
 
+/**
+ * @brief Sets how far from given coordinates the airports of a trip may be.
+ *
+ * Every trip from or to coordinates uses all the airports within this radius, or the closest airport/s when none is
+ * that near. A radius of 0 always picks the closest airport/s.
+ */
+void UI::location_radius() {
+    double radius;
+    cout << "Current search radius: " << logic.getLocationRadius() << " km" << endl;
+    while (true) {
+        std::string input;
+        cout << "Insert the new radius in kilometres (0 to use only the closest airport/s): ";
+        cin >> input;
+        try {
+            size_t read;
+            radius = stod(input, &read);
+            if (read == input.size() && radius >= 0) {
+                break;
+            }
+        } catch (const std::exception&) {
+        }
+        cout << "Please insert a valid distance" << endl;
+    }
+    logic.setLocationRadius(radius);
+    cout << endl;
+    back_menu();
+}
+
 /**
  * @brief Initiates the trip planning process based on user preferences.
  *
@@ -196,7 +227,7 @@ void UI::trip_planner(){
          << "A. Origin Airport (You may use the name or the code of the airport)" << endl
          << "B: Origin City (We'll pick all airports in the city)" << endl
          << "C. Origin Country (We'll pick all airports in the country)" << endl
-         << "D. Origin Coordinates (We'll pick the closest airport/s to the given coordinates)" << endl
+         << "D. Origin Coordinates (We'll pick the airports within the search radius, or the closest airport/s)" << endl
          << "Insert your option:";
     validate_input(op, 'A', 'D');
     string initial_Airport;
@@ -408,7 +439,7 @@ void UI::trip_planner(){
                     }
                     dest_lat = stod(str_lat);
                     dest_lon = stod(str_lon);
-                    vector<Airport> destinations = logic.FindClosestAirportsToLocation(dest_lat, dest_lon);
+                    vector<Airport> destinations = logic.AirportsNearLocation(dest_lat, dest_lon);
                     //CIty to location
                     filters = get_Filters(Avoid_Or_Only , Yes_or_No);
                     if(Yes_or_No){
@@ -521,7 +552,7 @@ void UI::trip_planner(){
                     }
                     dest_lat = stod(str_lat);
                     dest_lon = stod(str_lon);
-                    vector<Airport> destinations = logic.FindClosestAirportsToLocation(dest_lat, dest_lon);
+                    vector<Airport> destinations = logic.AirportsNearLocation(dest_lat, dest_lon);
                     if(Yes_or_No){
                         if(Avoid_Or_Only){
                             for(auto dest: destinations){
@@ -634,7 +665,7 @@ void UI::trip_planner(){
                     }
                     dest_lat = stod(str_lat);
                     dest_lon = stod(str_lon);
-                    vector<Airport> destinations = logic.FindClosestAirportsToLocation(dest_lat, dest_lon);
+                    vector<Airport> destinations = logic.AirportsNearLocation(dest_lat, dest_lon);
                     if(Yes_or_No){
                         if(Avoid_Or_Only){
                             for (auto dest: destinations){
@@ -659,6 +690,158 @@ void UI::trip_planner(){
     }
 }
 
+/**
+ * @brief Plans the trip with the fewest kilometres between two points.
+ *
+ * The origin and the destination may each be an airport, a city, a country or coordinates, in which case every airport
+ * of the city or country, or the airports within the search radius of the coordinates, is considered. Airline filters are honoured,
+ * and the user picks plain Dijkstra or A*, which both find a trip of the same length. The trip is printed together with its
+ * number of flights, its total distance and the number of airports the search settled, so the two searches can be compared.
+ */
+void UI::shortest_trip_planner(){
+    char op;
+    cout << "How would you like to chose your starting point?" << endl
+         << "A. Origin Airport (You may use the name or the code of the airport)" << endl
+         << "B: Origin City (We'll pick all airports in the city)" << endl
+         << "C. Origin Country (We'll pick all airports in the country)" << endl
+         << "D. Origin Coordinates (We'll pick the airports within the search radius, or the closest airport/s)" << endl
+         << "Insert your option:";
+    validate_input(op, 'A', 'D');
+    string origin;
+    string destination;
+    unordered_set<string> filters;
+    int choice = 0;
+    bool Avoid_Or_Only = false;
+    bool Yes_or_No;
+
+    switch (op) {
+        case 'A':
+            cout << "Insert the code of the airport where you would like to depart from:" << endl;
+            cin >> origin;
+            origin = find_apCode(origin);
+            break;
+        case 'B':
+            std::cin.ignore();
+            cout << "Insert the city where you would like to depart from(Introduce it in the format [City,Country] :" << endl;
+            std::getline(std::cin, origin);
+            break;
+        case 'C':
+            std::cin.ignore();
+            cout << "Insert the country where you would like to depart from:" << endl;
+            std::getline(std::cin, origin);
+            break;
+        case 'D':
+            std::cin.ignore();
+            cout << "Insert the coordinates where you would like to depart from(Introduce them in the format [Latitude,Longitude] :" << endl;
+            std::getline(std::cin, origin);
+            break;
+    }
+    double latitude, longitude;
+    while (op == 'D' && !parse_coordinates(origin, latitude, longitude)) {
+        cout << "Please insert valid coordinates in the format [Latitude,Longitude]:" << endl;
+        std::getline(std::cin, origin);
+    }
+    vector<Airport> origins = airports_at(origin, op - 'A' + 1);
+
+    get_destination(destination , choice , filters);
+    while (choice == 4 && !parse_coordinates(destination, latitude, longitude)) {
+        cout << "Please insert valid coordinates in the format [Latitude,Longitude]:" << endl;
+        std::getline(std::cin, destination);
+    }
+    vector<Airport> destinations = airports_at(destination, choice);
+
+    filters = get_Filters(Avoid_Or_Only , Yes_or_No);
+    int filterChoice = !Yes_or_No ? 1 : Avoid_Or_Only ? 3 : 2;
+
+    char search;
+    cout << "Which search would you like to use?" << endl
+         << "A. Dijkstra" << endl
+         << "B. A* (guided by the distance to the destination)" << endl
+         << "Insert your option:";
+    validate_input(search, 'A', 'B');
+
+    Trip trip = logic.ShortestDistanceTrip(origins, destinations, filterChoice, filters, search == 'B');
+    if(trip.airports.empty())
+    {
+        std::cout << "No trip available" << endl;
+    }
+    else
+    {
+        for(size_t i = 0 ; i + 1 < trip.airports.size() ; i++){
+            cout << trip.airports[i].getCode() << "->";
+        }
+        cout << trip.airports.back().getCode() << endl;
+        cout << trip.flights << " flight(s), " << trip.kilometres << " km" << endl;
+        cout << "Airports settled by the search: " << trip.settled << endl;
+    }
+    back_menu();
+}
+
+/**
+ * @brief Gets the airports a trip may start or end at.
+ *
+ * @param input The airport code, "City,Country", country or "Latitude,Longitude" typed by the user.
+ * @param choice The kind of point (1: Airport, 2: City, 3: Country, 4: Coordinates).
+ * @return The matching airports; empty if the input is not valid.
+ */
+vector<Airport> UI::airports_at(const std::string& input, int choice)
+{
+    auto commaPos = std::find(input.begin(), input.end(), ',');
+    std::string first = std::string(input.begin(), commaPos);
+    std::string second;
+    if (commaPos != input.end()) {
+        second = std::string(std::find_if_not(commaPos + 1, input.end(), ::isspace), input.end());
+    }
+    double latitude, longitude;
+
+    switch (choice) {
+        case 1:
+            return {Airport(input)};
+        case 2:
+            return logic.AirportsInCity(first, second);
+        case 3:
+            return logic.AirportsInCountry(input);
+        case 4:
+            if (!parse_coordinates(input, latitude, longitude)) {
+                return {};
+            }
+            return logic.AirportsNearLocation(latitude, longitude);
+        default:
+            return {};
+    }
+}
+
+/**
+ * @brief Reads coordinates typed by the user.
+ *
+ * @param input The coordinates, in the format "Latitude,Longitude".
+ * @param latitude Output, the latitude in degrees.
+ * @param longitude Output, the longitude in degrees.
+ * @return Whether the input holds two numbers and nothing else, with the latitude in [-90, 90] and the longitude in
+ * [-180, 180].
+ */
+bool UI::parse_coordinates(const std::string& input, double& latitude, double& longitude)
+{
+    auto commaPos = std::find(input.begin(), input.end(), ',');
+    if (commaPos == input.end()) {
+        return false;
+    }
+    std::string first = std::string(input.begin(), commaPos);
+    std::string second = std::string(commaPos + 1, input.end());
+    try {
+        size_t readFirst, readSecond;
+        latitude = stod(first, &readFirst);
+        longitude = stod(second, &readSecond);
+        if (std::find_if_not(first.begin() + readFirst, first.end(), ::isspace) != first.end() ||
+            std::find_if_not(second.begin() + readSecond, second.end(), ::isspace) != second.end()) {
+            return false;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180;
+}
+
 /**
  * @brief Obtains user input for the destination point and sets choice variable accordingly.
  *
@@ -674,7 +857,7 @@ void UI::get_destination(std::string& input , int& choice , unordered_set<std::s
          << "A. Destination Airport (You may use the name or the code of the airport)" << endl
          << "B: Destination City (We'll pick all airports in the city)" << endl
          << "C. Destination Country (We'll pick all airports in the country)" << endl
-         << "D. Destination Coordinates (We'll pick the closest airport/s to the given coordinates)" << endl
+         << "D. Destination Coordinates (We'll pick the airports within the search radius, or the closest airport/s)" << endl
          << "Insert your option:";
     validate_input(op, 'A', 'D');
     switch ((op)) {
@@ -691,8 +874,9 @@ void UI::get_destination(std::string& input , int& choice , unordered_set<std::s
             choice = 2;
             break;
         case 'C':
+            std::cin.ignore(); // Clear the input stream
             cout << "Insert the country of the airport where you would like to go to:" << endl;
-            cin >> input;
+            std::getline(std::cin, input);
             choice = 3;
             break;
         case 'D':
@@ -941,8 +1125,7 @@ void UI::number_out() {
         airport_code = "";
         cout << "What's the code of the airport you would like to know the information?: ";
         cin >> airport_code;
-        Airport airport = Airport(airport_code);
-        if(g.findVertex(airport)){
+        if(logic.IsAirport(airport_code)){
             break;
         }else{
             cout << "Please insert a valid airport code" << endl;
@@ -972,7 +1155,7 @@ void UI::number_flights() {
                 city_name = "";
                 cout << "What's the name of the city you would like to know the information?: ";
                 cin >> city_name;
-                if(this->cities.find(city_name) != this->cities.end()){
+                if(logic.IsCity(city_name)){
                     break;
                 }
             }
@@ -1012,7 +1195,7 @@ void UI::number_countries() {
                 city_name = "";
                 cout << "What's the name of the city you would like to know the information?: ";
                 cin >> city_name;
-                if(this->cities.find(city_name) != this->cities.end()){
+                if(logic.IsCity(city_name)){
                     break;
                 }
             }
@@ -1025,7 +1208,7 @@ void UI::number_countries() {
                 airport_code = "";
                 cout << "What's the code of the airport you would like to know the information?: ";
                 cin >> airport_code;
-                if(this->airport_codes.find(airport_code) != this->airlines.end()){
+                if(logic.IsAirport(airport_code)){
                     break;
                 }
             }
@@ -1044,7 +1227,7 @@ void UI::number_reachable_destinations() {
         airport_code = "";
         cout << "What's the code of the airport you would like to know the information?: ";
         cin >> airport_code;
-        if(this->airport_codes.find(airport_code) != this->airlines.end()){
+        if(logic.IsAirport(airport_code)){
             break;
         }
     }
@@ -1069,7 +1252,7 @@ void UI::number_reachable_destinations_k() {
         airport_code = "";
         cout << "What's the code of the airport you would like to know the information?: ";
         cin >> airport_code;
-        if(this->airport_codes.find(airport_code) != this->airlines.end()){
+        if(logic.IsAirport(airport_code)){
             break;
         }
     }
@@ -1097,18 +1280,11 @@ void UI::number_reachable_destinations_k() {
  */
 void UI::longest_trip(){
     cout << "The longest distance is: " << diameter << endl << "Here are the longest flights:" << endl;
-    for(auto v : g.getVertexSet())
+    LongestTripList trips = logic.LongestTrips(diameter);
+    for(size_t i = 0; i < trips.size(); i++)
     {
-        vector<vector<Airport>> a = logic.FindMaxTripBfs(v->getInfo() , diameter);
-        if(!a.empty()) {
-            for (auto v: a) {
-                vector<Airport> d = v;
-                Airport z = d[0];
-                Airport p = d[d.size() -1];
-                cout << z.getCode() << " to " << p.getCode();
-                cout << endl;
-            }
-        }
+        cout << trips.origin(i).getCode() << " to " << trips.destination(i).getCode();
+        cout << endl;
     }
     back_menu();
 }
@@ -1122,7 +1298,7 @@ void UI::greatest_traffic(){
         k = INT_MIN;
         cout << "What's the number of top airports you want to get information about?: ";
         cin >> k;
-        if(k >= 0 && k <= airport_codes.size()){
+        if(k >= 0 && k <= logic.GlobalNumberOfAirports()){
             break;
         }
     }
@@ -29,6 +29,10 @@ public:
     void airport_statistics();
     void flight_consultation();
     void trip_planner();
+    void shortest_trip_planner();
+    void location_radius();
+    vector<Airport> airports_at(const std::string& input, int choice);
+    static bool parse_coordinates(const std::string& input, double& latitude, double& longitude);
     void get_destination(std::string &input , int& choice , unordered_set<std::string>& filters);
     void printList(list<vector<Airport>> a);
 
@@ -38,8 +42,6 @@ public:
 
     void number_flights();
 
-    void load_sets();
-
     void back_menu();
 
     void number_countries();
@@ -57,11 +59,7 @@ public:
     std::string find_apCode(std::string& name);
     list<vector<Airport>> NormaliseList(list<vector<Airport>>& list1);
 private:
-    Graph<Airport> g;
-    Logic logic = Logic(g);
-    unordered_set<string> cities;
-    unordered_set<string> airport_codes;
-    unordered_set<string> countries;
+    Logic logic;
     unordered_set<string> airlines;
     int diameter;
 
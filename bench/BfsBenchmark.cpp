@@ -0,0 +1,81 @@
+/**
+ * @file BfsBenchmark.cpp
+ * @brief Compares the pointer-based Graph<Airport> BFS with the CsrGraph BFS on the shipped dataset.
+ *
+ * Runs one BFS from every airport with each representation and prints the total time of each sweep. Both sweeps
+ * also add up the eccentricities they find, so the two results can be checked against each other, and so does the
+ * bit-parallel CsrGraph::allSourcesBfs(). Then it compares the diameter found by those all-airports sweeps with
+ * CsrGraph::findDiameter(), which bounds eccentricities instead.
+ * Run it from a directory that contains the dataset folder (e.g. cmake-build-debug).
+ */
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include "../Logic/Graph.h"
+#include "../Logic/CsrGraph.h"
+#include "../Logic/LoadingFunctions.h"
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedMs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+int main() {
+    Graph<Airport> g;
+    LoadingFunctions::LoadFlights(g);
+
+    auto start = Clock::now();
+    CsrGraph csr(g);
+    std::cout << "CSR build: " << elapsedMs(start) << " ms (" << csr.getNumVertex() << " airports, "
+              << csr.getNumEdges() << " routes, " << csr.getNumFlights() << " flights)" << std::endl;
+
+    start = Clock::now();
+    long long pointerSum = 0;
+    for (auto v : g.getVertexSet()) {
+        Airport airport = v->getInfo();
+        g.bfsDifferent(airport);
+        int eccentricity = 0;
+        for (auto w : g.getVertexSet()) {
+            if (w->isVisited() && w->getNum() > eccentricity) {
+                eccentricity = w->getNum();
+            }
+        }
+        pointerSum += eccentricity;
+    }
+    std::cout << "Pointer BFS from every airport: " << elapsedMs(start) << " ms (eccentricity sum "
+              << pointerSum << ")" << std::endl;
+
+    start = Clock::now();
+    long long csrSum = 0;
+    int sweepDiameter = 0;
+    StampedArray<int> dist(-1);
+    std::vector<int> queue;
+    for (int v = 0; v < csr.getNumVertex(); v++) {
+        int eccentricity = csr.bfs(v, dist, queue);
+        csrSum += eccentricity;
+        sweepDiameter = std::max(sweepDiameter, eccentricity);
+    }
+    std::cout << "CSR BFS from every airport: " << elapsedMs(start) << " ms (eccentricity sum "
+              << csrSum << ", diameter " << sweepDiameter << ", " << csr.getNumVertex() << " BFS runs)" << std::endl;
+
+    start = Clock::now();
+    CsrGraph::HopSummary summary = csr.allSourcesBfs();
+    long long batchSum = 0;
+    for (int eccentricity : summary.eccentricity) {
+        batchSum += eccentricity;
+    }
+    std::cout << "Bit-parallel BFS from every airport: " << elapsedMs(start) << " ms (eccentricity sum " << batchSum
+              << ", diameter " << summary.diameter << ", " << summary.farthestPairs.size() << " farthest pairs)"
+              << std::endl;
+
+    start = Clock::now();
+    CsrGraph::Diameter diameter = csr.findDiameter();
+    std::cout << "Eccentricity-bounding diameter: " << elapsedMs(start) << " ms (diameter " << diameter.hops << ", "
+              << diameter.bfsRuns << " BFS runs, " << csr.getAirport(diameter.from).getCode() << " -> "
+              << csr.getAirport(diameter.to).getCode() << ")" << std::endl;
+
+    csr.bfs(diameter.from, dist, queue);
+    bool witnessOk = dist[diameter.to] == diameter.hops;
+    return pointerSum == csrSum && csrSum == batchSum && sweepDiameter == summary.diameter && sweepDiameter == diameter.hops && witnessOk ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file DiameterCheck.cpp
+ * @brief Checks CsrGraph::findDiameter() against a BFS from every airport on random directed graphs.
+ *
+ * Generates graphs of up to 80 airports with one-way routes, from sparse ones that split into many components to
+ * dense ones, so the eccentricity bounds are exercised on graphs that are not strongly connected. For each graph the
+ * diameter found by bounding eccentricities must equal the greatest eccentricity of the exhaustive sweep, and its
+ * witness pair must be that many hops apart. Prints every mismatch and exits with 1 if there is any.
+ * Needs no dataset.
+ */
+#include <iostream>
+#include <random>
+#include <string>
+#include <algorithm>
+#include "../Logic/Graph.h"
+#include "../Logic/CsrGraph.h"
+
+int main() {
+    const int graphs = 400;
+    std::mt19937 random(2024);
+    StampedArray<int> dist(-1);
+    std::vector<int> queue;
+    int mismatches = 0;
+    long long bfsRuns = 0, sweepRuns = 0;
+
+    for (int t = 0; t < graphs; t++) {
+        int n = std::uniform_int_distribution<int>(1, 80)(random);
+        // Mean out-degree between 0.5 and 4, so the sparse graphs are far from strongly connected
+        double degree = std::uniform_real_distribution<double>(0.5, 4.0)(random);
+        std::uniform_int_distribution<int> airport(0, n - 1);
+
+        Graph<Airport> g;
+        std::vector<Airport> airports;
+        for (int i = 0; i < n; i++) {
+            airports.emplace_back("A" + std::to_string(i), "Airport", "City", "Country", 0.0, 0.0);
+            g.addVertex(airports.back());
+        }
+        int routes = (int) (degree * n);
+        for (int r = 0; r < routes; r++) {
+            int from = airport(random), to = airport(random);
+            if (from != to) {
+                g.addEdge(airports[from], airports[to], 1.0, "AAA");
+            }
+        }
+
+        CsrGraph csr(g);
+        int sweepDiameter = 0;
+        for (int v = 0; v < csr.getNumVertex(); v++) {
+            sweepDiameter = std::max(sweepDiameter, csr.bfs(v, dist, queue));
+        }
+        sweepRuns += csr.getNumVertex();
+
+        CsrGraph::Diameter diameter = csr.findDiameter();
+        bfsRuns += diameter.bfsRuns;
+        bool witnessOk = diameter.hops == 0;
+        if (diameter.from >= 0) {
+            csr.bfs(diameter.from, dist, queue);
+            witnessOk = dist[diameter.to] == diameter.hops;
+        }
+        if (diameter.hops != sweepDiameter || !witnessOk) {
+            mismatches++;
+            std::cout << "Graph " << t << " (" << n << " airports, " << csr.getNumEdges() << " routes): diameter "
+                      << diameter.hops << ", expected " << sweepDiameter << (witnessOk ? "" : ", bad witness")
+                      << std::endl;
+        }
+    }
+
+    std::cout << graphs << " random directed graphs, " << mismatches << " mismatches (" << bfsRuns
+              << " BFS runs bounding eccentricities, " << sweepRuns << " in the exhaustive sweeps)" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file HaversineBenchmark.cpp
+ * @brief Compares the scalar Haversine formula with the batch kernel on the distance matrix of every airport.
+ *
+ * It prints the time per pair of each version and the largest difference between them, which must stay within half
+ * a metre (the scalar formula's own error near antipodal airports).
+ * Run it from a directory that contains the dataset folder (e.g. cmake-build-debug).
+ */
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "../Logic/CsrGraph.h"
+#include "../Logic/Haversine.h"
+#include "../Logic/LoadingFunctions.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+int main() {
+    Graph<Airport> g;
+    LoadingFunctions::LoadFlights(g);
+    CsrGraph csr(g);
+
+    size_t n = csr.getNumVertex();
+    std::vector<double> latitudes(n), longitudes(n);
+    for (size_t v = 0; v < n; v++) {
+        latitudes[v] = csr.getAirport(v).getLatitude();
+        longitudes[v] = csr.getAirport(v).getLongitude();
+    }
+    std::vector<double> scalar(n * n), batch(n * n);
+
+    auto start = Clock::now();
+    for (size_t u = 0; u < n; u++) {
+        for (size_t v = 0; v < n; v++) {
+            scalar[u * n + v] = Haversine::distance(latitudes[u], longitudes[u], latitudes[v], longitudes[v]);
+        }
+    }
+    double scalarNs = elapsedNs(start);
+
+    start = Clock::now();
+    for (size_t u = 0; u < n; u++) {
+        Haversine::distancesFrom(latitudes[u], longitudes[u], latitudes.data(), longitudes.data(),
+                                 batch.data() + u * n, n);
+    }
+    double batchNs = elapsedNs(start);
+
+    double difference = 0;
+    for (size_t i = 0; i < n * n; i++) {
+        difference = std::max(difference, std::abs(scalar[i] - batch[i]));
+    }
+
+    double pairs = (double) n * n;
+    std::cout << "Distance matrix of " << n << " airports (" << (size_t) pairs << " pairs)" << std::endl;
+    std::cout << "Scalar: " << scalarNs / pairs << " ns/pair" << std::endl;
+    std::cout << "Batch: " << batchNs / pairs << " ns/pair" << std::endl;
+    std::cout << "Largest difference: " << difference << " km" << std::endl;
+
+    return difference <= 5e-4 + Haversine::MaxError ? 0 : 1;
+}
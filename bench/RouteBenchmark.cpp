@@ -0,0 +1,53 @@
+/**
+ * @file RouteBenchmark.cpp
+ * @brief Compares Dijkstra with A* on the shortest-distance route between long intercontinental airport pairs.
+ *
+ * For every pair it prints the length of the route found by each search, which must be equal, and the number of
+ * airports each search settled before reaching the destination.
+ * Run it from a directory that contains the dataset folder (e.g. cmake-build-debug).
+ */
+#include <iostream>
+#include <chrono>
+#include "../Logic/Logic.h"
+#include "../Logic/LoadingFunctions.h"
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+int main() {
+    Graph<Airport> g;
+    LoadingFunctions::LoadFlights(g);
+    Logic logic(g);
+
+    const std::pair<std::string, std::string> pairs[] = {
+            {"OPO", "SYD"}, {"LIS", "NRT"}, {"JFK", "SIN"}, {"GRU", "PEK"},
+            {"LAX", "JNB"}, {"SCL", "DEL"}, {"YVR", "AKL"}, {"CPT", "HNL"},
+    };
+
+    int status = 0;
+    for (const auto& pair : pairs) {
+        std::vector<Airport> from = {Airport(pair.first)};
+        std::vector<Airport> to = {Airport(pair.second)};
+
+        auto start = Clock::now();
+        Trip dijkstra = logic.ShortestDistanceTrip(from, to, 1, {}, false);
+        long long dijkstraUs = elapsedUs(start);
+
+        start = Clock::now();
+        Trip aStar = logic.ShortestDistanceTrip(from, to, 1, {}, true);
+        long long aStarUs = elapsedUs(start);
+
+        std::cout << pair.first << " -> " << pair.second << ": " << aStar.kilometres << " km in "
+                  << aStar.flights << " flight(s); settled " << dijkstra.settled << " (Dijkstra, " << dijkstraUs
+                  << " us) vs " << aStar.settled << " (A*, " << aStarUs << " us)" << std::endl;
+
+        if (std::abs(dijkstra.kilometres - aStar.kilometres) > 1e-6) {
+            status = 1;
+        }
+    }
+
+    return status;
+}
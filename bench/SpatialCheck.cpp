@@ -0,0 +1,99 @@
+/**
+ * @file SpatialCheck.cpp
+ * @brief Checks the SpatialIndex queries against a Haversine scan of every airport on the shipped dataset.
+ *
+ * Asks nearest(), kNearest() and withinRadius() about random locations, about the exact coordinates of airports
+ * (where airports sharing a position tie) and about points nudged a few ulps off them. The radii include the exact
+ * distance of some airport, so the slack the index adds to its chord bound decides whether that airport is in range.
+ * Every answer must equal the one computed from Haversine::distance() to all the airports, ties broken by id.
+ * Prints every mismatch and exits with 1 if there is any.
+ * Run it from a directory that contains the dataset folder (e.g. cmake-build-debug).
+ */
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "../Logic/CsrGraph.h"
+#include "../Logic/SpatialIndex.h"
+#include "../Logic/Haversine.h"
+#include "../Logic/LoadingFunctions.h"
+
+static void report(const char* query, double latitude, double longitude, int& mismatches) {
+    mismatches++;
+    std::cout.precision(17);
+    std::cout << query << " differs at (" << latitude << ", " << longitude << ")" << std::endl;
+}
+
+int main() {
+    Graph<Airport> g;
+    LoadingFunctions::LoadFlights(g);
+    CsrGraph csr(g);
+    SpatialIndex index(csr);
+
+    const int queries = 6500;
+    int n = csr.getNumVertex();
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> latitude(-90, 90), longitude(-180, 180);
+    std::uniform_int_distribution<int> airport(0, n - 1);
+    int mismatches = 0;
+
+    for (int q = 0; q < queries; q++) {
+        double lat, lon;
+        if (q % 3 == 0) {
+            lat = latitude(random);
+            lon = longitude(random);
+        } else {
+            const Airport& a = csr.getAirport(airport(random));
+            lat = a.getLatitude();
+            lon = a.getLongitude();
+            if (q % 3 == 2) {
+                lat = std::nextafter(lat, lat + (random() % 2 ? 1 : -1));
+                lon = std::nextafter(lon, lon + (random() % 2 ? 1 : -1));
+            }
+        }
+
+        std::vector<std::pair<double, int>> all;
+        for (int v = 0; v < n; v++) {
+            const Airport& a = csr.getAirport(v);
+            all.emplace_back(Haversine::distance(lat, lon, a.getLatitude(), a.getLongitude()), v);
+        }
+        std::sort(all.begin(), all.end());
+
+        std::vector<int> nearest;
+        for (const auto& entry : all) {
+            if (entry.first == all[0].first) {
+                nearest.push_back(entry.second);
+            }
+        }
+        if (index.nearest(lat, lon) != nearest) {
+            report("nearest", lat, lon, mismatches);
+        }
+
+        size_t k = 1 + random() % 20;
+        std::vector<int> kNearest;
+        for (size_t i = 0; i < k; i++) {
+            kNearest.push_back(all[i].second);
+        }
+        if (index.kNearest(lat, lon, k) != kNearest) {
+            report("kNearest", lat, lon, mismatches);
+        }
+
+        // Half of the radii are the exact distance of an airport, which must then be in range
+        double radius = q % 2 ? all[airport(random)].first : std::uniform_real_distribution<double>(0, 3000)(random);
+        std::vector<int> inRange;
+        for (const auto& entry : all) {
+            if (entry.first <= radius) {
+                inRange.push_back(entry.second);
+            }
+        }
+        std::sort(inRange.begin(), inRange.end());
+        if (index.withinRadius(lat, lon, radius) != inRange) {
+            report("withinRadius", lat, lon, mismatches);
+        }
+    }
+
+    std::cout << queries << " query points, " << 3 * queries << " queries, " << mismatches << " mismatches"
+              << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
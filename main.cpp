@@ -55,12 +55,12 @@ int main() {
 
         std::cout << "Time taken by calculateDiameter: " << duration1.count()/1000 << " seconds" << std::endl;
 
-        std::pair< std::vector<std::pair<Airport, Airport>> , int> d = logic.AirportAtMaximumDistance();
+        std::pair<std::vector<Trip>, int> d = logic.AirportAtMaximumDistance();
 
-        for( auto pair : d.first)
+        for(const auto& trip : d.first)
         {
-            std::cout << "initial airport : " << pair.first.getCode()
-            << " | end airport: " << pair.second.getCode() << " | number of layovers: " << d.second << endl;
+            std::cout << "initial airport : " << trip.airports.front().getCode()
+            << " | end airport: " << trip.airports.back().getCode() << " | number of layovers: " << d.second << endl;
         }
 
         Airport airport = Airport("INL");